@@ -0,0 +1,788 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace euler
+{
+    namespace detail
+    {
+        /// <summary>
+        /// The storage for the limbs of a BigInt. Values of up to c_inlineLimbs limbs, i.e. 128 bits, are stored
+        /// inline so that the common small values never allocate, and larger values move to the heap.
+        /// </summary>
+        class LimbBuffer
+        {
+        public:
+            static constexpr std::size_t c_inlineLimbs = 4;
+
+            LimbBuffer() = default;
+
+            LimbBuffer(const LimbBuffer& p_other)
+            {
+                Resize(p_other.m_size);
+                std::copy_n(p_other.data(), p_other.m_size, data());
+            }
+
+            LimbBuffer& operator=(const LimbBuffer& p_other)
+            {
+                if (this != &p_other)
+                {
+                    Resize(p_other.m_size);
+                    std::copy_n(p_other.data(), p_other.m_size, data());
+                }
+                return *this;
+            }
+
+            LimbBuffer(LimbBuffer&& p_other) noexcept
+            {
+                *this = std::move(p_other);
+            }
+
+            LimbBuffer& operator=(LimbBuffer&& p_other) noexcept
+            {
+                if (this != &p_other)
+                {
+                    m_inline = p_other.m_inline;
+                    m_heap = std::move(p_other.m_heap);
+                    m_size = std::exchange(p_other.m_size, 0);
+                    m_capacity = std::exchange(p_other.m_capacity, c_inlineLimbs);
+                }
+                return *this;
+            }
+
+            uint32_t* data()
+            {
+                return m_heap ? m_heap.get() : m_inline.data();
+            }
+
+            const uint32_t* data() const
+            {
+                return m_heap ? m_heap.get() : m_inline.data();
+            }
+
+            std::size_t size() const
+            {
+                return m_size;
+            }
+
+            bool empty() const
+            {
+                return m_size == 0;
+            }
+
+            uint32_t& operator[](std::size_t p_index)
+            {
+                return data()[p_index];
+            }
+
+            uint32_t operator[](std::size_t p_index) const
+            {
+                return data()[p_index];
+            }
+
+            std::span<uint32_t> Span()
+            {
+                return std::span<uint32_t>(data(), m_size);
+            }
+
+            std::span<const uint32_t> Span() const
+            {
+                return std::span<const uint32_t>(data(), m_size);
+            }
+
+            /// <summary>
+            /// Changes the number of limbs. Added limbs are 0.
+            /// </summary>
+            void Resize(std::size_t p_size)
+            {
+                if (p_size > m_capacity)
+                {
+                    // Grow geometrically so that repeated growth by one limb stays amortized constant.
+                    const auto capacity = std::max(p_size, m_capacity * 2);
+                    auto heap = std::make_unique<uint32_t[]>(capacity);
+                    std::copy_n(data(), m_size, heap.get());
+                    m_heap = std::move(heap);
+                    m_capacity = capacity;
+                }
+                if (p_size > m_size)
+                {
+                    std::fill(data() + m_size, data() + p_size, 0u);
+                }
+                m_size = p_size;
+            }
+
+            void PushBack(uint32_t p_limb)
+            {
+                Resize(m_size + 1);
+                data()[m_size - 1] = p_limb;
+            }
+
+            /// <summary>
+            /// Removes the most significant limbs that are 0, so that every value has a unique representation.
+            /// </summary>
+            void Trim()
+            {
+                while (m_size > 0 && data()[m_size - 1] == 0)
+                {
+                    --m_size;
+                }
+            }
+
+        private:
+            std::array<uint32_t, c_inlineLimbs> m_inline{};
+            std::unique_ptr<uint32_t[]> m_heap;
+            std::size_t m_size{};
+            std::size_t m_capacity{ c_inlineLimbs };
+        };
+
+        /// <summary>
+        /// Products where both sides have at least this many limbs use Karatsuba multiplication, below it the
+        /// schoolbook method is faster.
+        /// </summary>
+        constexpr std::size_t c_karatsubaThreshold = 32;
+
+        /// <summary>
+        /// Compares two magnitudes, which may have leading zero limbs.
+        /// </summary>
+        inline std::strong_ordering CompareLimbs(std::span<const uint32_t> p_a, std::span<const uint32_t> p_b)
+        {
+            while (!p_a.empty() && p_a.back() == 0)
+            {
+                p_a = p_a.first(p_a.size() - 1);
+            }
+            while (!p_b.empty() && p_b.back() == 0)
+            {
+                p_b = p_b.first(p_b.size() - 1);
+            }
+
+            if (p_a.size() != p_b.size())
+            {
+                return p_a.size() <=> p_b.size();
+            }
+            for (auto i = p_a.size(); i-- > 0; )
+            {
+                if (p_a[i] != p_b[i])
+                {
+                    return p_a[i] <=> p_b[i];
+                }
+            }
+            return std::strong_ordering::equal;
+        }
+
+        /// <summary>
+        /// Adds p_value into p_target starting at limb p_offset, and propagates the carry through p_target.
+        /// </summary>
+        /// <returns>The carry out of the most significant limb of p_target.</returns>
+        inline uint32_t AddLimbsAt(std::span<uint32_t> p_target, std::span<const uint32_t> p_value, std::size_t p_offset)
+        {
+            uint64_t carry = 0;
+            std::size_t i = 0;
+            for (; i < p_value.size(); ++i)
+            {
+                carry += uint64_t{ p_target[p_offset + i] } + p_value[i];
+                p_target[p_offset + i] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            for (i += p_offset; carry != 0 && i < p_target.size(); ++i)
+            {
+                carry += p_target[i];
+                p_target[i] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            return static_cast<uint32_t>(carry);
+        }
+
+        /// <summary>
+        /// Subtracts p_value from p_target in place, where p_target is at least as large.
+        /// </summary>
+        inline void SubtractLimbs(std::span<uint32_t> p_target, std::span<const uint32_t> p_value)
+        {
+            int64_t borrow = 0;
+            std::size_t i = 0;
+            for (; i < p_value.size(); ++i)
+            {
+                borrow += int64_t{ p_target[i] } - p_value[i];
+                p_target[i] = static_cast<uint32_t>(borrow);
+                borrow >>= 32;
+            }
+            for (; borrow != 0 && i < p_target.size(); ++i)
+            {
+                borrow += p_target[i];
+                p_target[i] = static_cast<uint32_t>(borrow);
+                borrow >>= 32;
+            }
+        }
+
+        /// <summary>
+        /// Multiplies by the schoolbook method, adding the product into p_out which must hold
+        /// p_a.size() + p_b.size() limbs.
+        /// </summary>
+        inline void MultiplySchoolbook(
+            std::span<const uint32_t> p_a,
+            std::span<const uint32_t> p_b,
+            std::span<uint32_t> p_out)
+        {
+            for (std::size_t i = 0; i < p_a.size(); ++i)
+            {
+                if (p_a[i] == 0)
+                {
+                    continue;
+                }
+
+                uint64_t carry = 0;
+                for (std::size_t j = 0; j < p_b.size(); ++j)
+                {
+                    carry += uint64_t{ p_a[i] } * p_b[j] + p_out[i + j];
+                    p_out[i + j] = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+                for (auto k = i + p_b.size(); carry != 0; ++k)
+                {
+                    carry += p_out[k];
+                    p_out[k] = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Multiplies two magnitudes into p_out, which must hold p_a.size() + p_b.size() limbs and be 0. Karatsuba
+        /// splits both sides at half the limbs, a = a1 B + a0 and b = b1 B + b0, and replaces the four half sized
+        /// products with three: ab = z2 B^2 + (z1 - z2 - z0) B + z0 where z0 = a0 b0, z2 = a1 b1 and
+        /// z1 = (a0 + a1)(b0 + b1). This gives O(n^1.585) rather than O(n^2).
+        /// </summary>
+        inline void MultiplyLimbs(std::span<const uint32_t> p_a, std::span<const uint32_t> p_b, std::span<uint32_t> p_out)
+        {
+            if (p_a.size() < p_b.size())
+            {
+                std::swap(p_a, p_b);
+            }
+            if (p_b.size() < c_karatsubaThreshold)
+            {
+                MultiplySchoolbook(p_a, p_b, p_out);
+                return;
+            }
+
+            const auto half = (p_a.size() + 1) / 2;
+            if (p_b.size() <= half)
+            {
+                // Too unbalanced to split both sides, so multiply b by chunks of a of its own size instead.
+                std::vector<uint32_t> partial(2 * p_b.size());
+                for (std::size_t offset = 0; offset < p_a.size(); offset += p_b.size())
+                {
+                    const auto chunk = p_a.subspan(offset, std::min(p_b.size(), p_a.size() - offset));
+                    std::fill(partial.begin(), partial.end(), 0u);
+                    const auto product = std::span<uint32_t>(partial).first(chunk.size() + p_b.size());
+                    MultiplyLimbs(chunk, p_b, product);
+                    AddLimbsAt(p_out, product, offset);
+                }
+                return;
+            }
+
+            const auto a0 = p_a.first(half);
+            const auto a1 = p_a.subspan(half);
+            const auto b0 = p_b.first(half);
+            const auto b1 = p_b.subspan(half);
+
+            // z0 and z2 do not overlap so they are written into their final place directly.
+            MultiplyLimbs(a0, b0, p_out.first(2 * half));
+            MultiplyLimbs(a1, b1, p_out.subspan(2 * half));
+
+            std::vector<uint32_t> aSum(half + 1);
+            std::copy(a0.begin(), a0.end(), aSum.begin());
+            AddLimbsAt(aSum, a1, 0);
+            std::vector<uint32_t> bSum(half + 1);
+            std::copy(b0.begin(), b0.end(), bSum.begin());
+            AddLimbsAt(bSum, b1, 0);
+
+            std::vector<uint32_t> middle(2 * half + 2);
+            MultiplyLimbs(aSum, bSum, middle);
+            SubtractLimbs(middle, p_out.first(2 * half));
+            SubtractLimbs(middle, p_out.subspan(2 * half));
+
+            // The middle term is below B^2 so its top limbs are 0 and only the rest needs to be added.
+            auto used = middle.size();
+            while (used > 0 && middle[used - 1] == 0)
+            {
+                --used;
+            }
+            AddLimbsAt(p_out, std::span<const uint32_t>(middle).first(used), half);
+        }
+
+        /// <summary>
+        /// Divides a magnitude by a single limb in place.
+        /// </summary>
+        /// <returns>The remainder.</returns>
+        inline uint32_t DivideLimbsInPlace(std::span<uint32_t> p_value, uint32_t p_divisor)
+        {
+            uint64_t remainder = 0;
+            for (auto i = p_value.size(); i-- > 0; )
+            {
+                const auto current = (remainder << 32) | p_value[i];
+                p_value[i] = static_cast<uint32_t>(current / p_divisor);
+                remainder = current % p_divisor;
+            }
+            return static_cast<uint32_t>(remainder);
+        }
+
+        /// <summary>
+        /// Divides magnitudes with Knuth's algorithm D, where the divisor has at least two limbs and no leading zero
+        /// limbs. The quotient needs p_u.size() - p_v.size() + 1 limbs and the remainder p_v.size() limbs.
+        /// </summary>
+        inline void DivideLimbs(
+            std::span<const uint32_t> p_u,
+            std::span<const uint32_t> p_v,
+            std::span<uint32_t> p_quotient,
+            std::span<uint32_t> p_remainder)
+        {
+            const auto n = p_v.size();
+            const auto m = p_u.size() - n;
+
+            // Normalize so that the top bit of the divisor is set, which keeps each quotient digit estimate within
+            // 2 of the true value.
+            const auto shift = std::countl_zero(p_v.back());
+            std::vector<uint32_t> v(n);
+            std::vector<uint32_t> u(p_u.size() + 1);
+            for (auto i = n; i-- > 1; )
+            {
+                v[i] = shift == 0 ? p_v[i] : (p_v[i] << shift) | (p_v[i - 1] >> (32 - shift));
+            }
+            v[0] = p_v[0] << shift;
+            u[p_u.size()] = shift == 0 ? 0 : p_u.back() >> (32 - shift);
+            for (auto i = p_u.size(); i-- > 1; )
+            {
+                u[i] = shift == 0 ? p_u[i] : (p_u[i] << shift) | (p_u[i - 1] >> (32 - shift));
+            }
+            u[0] = p_u[0] << shift;
+
+            constexpr uint64_t c_base = uint64_t{ 1 } << 32;
+            for (auto j = m + 1; j-- > 0; )
+            {
+                // Estimate the quotient digit from the top two limbs, and correct it with the third.
+                const auto top = (uint64_t{ u[j + n] } << 32) | u[j + n - 1];
+                auto estimate = top / v[n - 1];
+                auto remainder = top % v[n - 1];
+                while (estimate >= c_base || estimate * v[n - 2] > ((remainder << 32) | u[j + n - 2]))
+                {
+                    --estimate;
+                    remainder += v[n - 1];
+                    if (remainder >= c_base)
+                    {
+                        break;
+                    }
+                }
+
+                // Multiply and subtract.
+                int64_t borrow = 0;
+                uint64_t carry = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    carry += estimate * v[i];
+                    borrow += int64_t{ u[i + j] } - static_cast<int64_t>(carry & 0xFFFF'FFFF);
+                    u[i + j] = static_cast<uint32_t>(borrow);
+                    carry >>= 32;
+                    borrow >>= 32;
+                }
+                borrow += int64_t{ u[j + n] } - static_cast<int64_t>(carry);
+                u[j + n] = static_cast<uint32_t>(borrow);
+
+                // The estimate was one too large, which is rare, so add the divisor back once.
+                if (borrow < 0)
+                {
+                    --estimate;
+                    uint64_t addCarry = 0;
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        addCarry += uint64_t{ u[i + j] } + v[i];
+                        u[i + j] = static_cast<uint32_t>(addCarry);
+                        addCarry >>= 32;
+                    }
+                    u[j + n] += static_cast<uint32_t>(addCarry);
+                }
+
+                p_quotient[j] = static_cast<uint32_t>(estimate);
+            }
+
+            // Undo the normalization for the remainder.
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                p_remainder[i] = shift == 0 ? u[i] : (u[i] >> shift) | (u[i + 1] << (32 - shift));
+            }
+        }
+    }
+
+    /// <summary>
+    /// An arbitrary precision signed integer. The magnitude is stored as 32 bit limbs, least significant first,
+    /// with values of up to 128 bits stored inline. Multiplication switches from the schoolbook method to
+    /// Karatsuba once both sides are large, and division is Knuth's algorithm D. Division truncates towards zero,
+    /// and the remainder takes the sign of the dividend, as for the built in integers.
+    /// </summary>
+    class BigInt
+    {
+    public:
+        BigInt() = default;
+
+        template <std::integral T>
+        BigInt(T p_value)
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                m_negative = p_value < 0;
+            }
+
+            // Negate in the unsigned type so that the minimum value does not overflow.
+            auto magnitude = static_cast<uint64_t>(p_value);
+            if (m_negative)
+            {
+                magnitude = 0 - magnitude;
+            }
+            for (; magnitude != 0; magnitude >>= 32)
+            {
+                m_limbs.PushBack(static_cast<uint32_t>(magnitude));
+            }
+        }
+
+        /// <summary>
+        /// Parses a decimal value with an optional leading sign.
+        /// </summary>
+        explicit BigInt(std::string_view p_text)
+        {
+            auto negative = false;
+            if (!p_text.empty() && (p_text.front() == '-' || p_text.front() == '+'))
+            {
+                negative = p_text.front() == '-';
+                p_text.remove_prefix(1);
+            }
+            if (p_text.empty())
+            {
+                throw std::invalid_argument("The text does not contain a number.");
+            }
+
+            // Consume 9 digits at a time, which is the most that fit in one limb.
+            const auto head = p_text.size() % 9 == 0 ? 9 : p_text.size() % 9;
+            for (std::size_t i = 0; i < p_text.size(); )
+            {
+                const auto count = i == 0 ? head : 9;
+                uint32_t chunk = 0;
+                uint32_t scale = 1;
+                for (auto c : p_text.substr(i, count))
+                {
+                    if (c < '0' || c > '9')
+                    {
+                        throw std::invalid_argument("The text is not a decimal number.");
+                    }
+                    chunk = chunk * 10 + static_cast<uint32_t>(c - '0');
+                    scale *= 10;
+                }
+                MultiplyAdd(scale, chunk);
+                i += count;
+            }
+
+            m_negative = negative && !IsZero();
+        }
+
+        bool IsZero() const
+        {
+            return m_limbs.empty();
+        }
+
+        bool IsNegative() const
+        {
+            return m_negative;
+        }
+
+        /// <summary>
+        /// The number of 32 bit limbs in the magnitude.
+        /// </summary>
+        std::size_t LimbCount() const
+        {
+            return m_limbs.size();
+        }
+
+        /// <summary>
+        /// Converts to a built in integer, keeping the low bits as a cast between integer types would.
+        /// </summary>
+        template <std::integral T>
+            requires (!std::same_as<T, bool>)
+        explicit operator T() const
+        {
+            uint64_t magnitude = 0;
+            for (std::size_t i = 0; i < std::min<std::size_t>(m_limbs.size(), 2); ++i)
+            {
+                magnitude |= uint64_t{ m_limbs[i] } << (32 * i);
+            }
+            return static_cast<T>(m_negative ? 0 - magnitude : magnitude);
+        }
+
+        /// <summary>
+        /// Whether the value is non-zero. This looks at the whole magnitude rather than the low bits that the
+        /// integer conversion keeps.
+        /// </summary>
+        explicit operator bool() const
+        {
+            return !IsZero();
+        }
+
+        /// <summary>
+        /// Formats the value in decimal.
+        /// </summary>
+        std::string ToString() const
+        {
+            if (IsZero())
+            {
+                return "0";
+            }
+
+            // Peel off 9 decimal digits at a time from the least significant end.
+            auto limbs = m_limbs;
+            auto remaining = limbs.size();
+            std::vector<uint32_t> chunks;
+            while (remaining > 0)
+            {
+                chunks.push_back(detail::DivideLimbsInPlace(limbs.Span().first(remaining), 1'000'000'000));
+                while (remaining > 0 && limbs[remaining - 1] == 0)
+                {
+                    --remaining;
+                }
+            }
+
+            std::string text = m_negative ? "-" : "";
+            text += std::to_string(chunks.back());
+            for (auto it = chunks.rbegin() + 1; it != chunks.rend(); ++it)
+            {
+                const auto chunk = std::to_string(*it);
+                text.append(9 - chunk.size(), '0');
+                text += chunk;
+            }
+            return text;
+        }
+
+        friend bool operator==(const BigInt& p_a, const BigInt& p_b)
+        {
+            return p_a.m_negative == p_b.m_negative &&
+                std::ranges::equal(p_a.m_limbs.Span(), p_b.m_limbs.Span());
+        }
+
+        friend std::strong_ordering operator<=>(const BigInt& p_a, const BigInt& p_b)
+        {
+            if (p_a.m_negative != p_b.m_negative)
+            {
+                return p_a.m_negative ? std::strong_ordering::less : std::strong_ordering::greater;
+            }
+
+            const auto magnitude = detail::CompareLimbs(p_a.m_limbs.Span(), p_b.m_limbs.Span());
+            return p_a.m_negative ? 0 <=> magnitude : magnitude;
+        }
+
+        BigInt operator-() const
+        {
+            auto result = *this;
+            result.m_negative = !m_negative && !IsZero();
+            return result;
+        }
+
+        BigInt& operator+=(const BigInt& p_other)
+        {
+            AddSigned(p_other, p_other.m_negative);
+            return *this;
+        }
+
+        BigInt& operator-=(const BigInt& p_other)
+        {
+            AddSigned(p_other, !p_other.m_negative);
+            return *this;
+        }
+
+        BigInt& operator*=(const BigInt& p_other)
+        {
+            *this = *this * p_other;
+            return *this;
+        }
+
+        BigInt& operator/=(const BigInt& p_other)
+        {
+            *this = DivMod(*this, p_other).first;
+            return *this;
+        }
+
+        BigInt& operator%=(const BigInt& p_other)
+        {
+            *this = DivMod(*this, p_other).second;
+            return *this;
+        }
+
+        friend BigInt operator+(BigInt p_a, const BigInt& p_b)
+        {
+            return p_a += p_b;
+        }
+
+        friend BigInt operator-(BigInt p_a, const BigInt& p_b)
+        {
+            return p_a -= p_b;
+        }
+
+        friend BigInt operator*(const BigInt& p_a, const BigInt& p_b)
+        {
+            BigInt result;
+            if (p_a.IsZero() || p_b.IsZero())
+            {
+                return result;
+            }
+
+            result.m_limbs.Resize(p_a.m_limbs.size() + p_b.m_limbs.size());
+            detail::MultiplyLimbs(p_a.m_limbs.Span(), p_b.m_limbs.Span(), result.m_limbs.Span());
+            result.m_limbs.Trim();
+            result.m_negative = p_a.m_negative != p_b.m_negative;
+            return result;
+        }
+
+        friend BigInt operator/(const BigInt& p_a, const BigInt& p_b)
+        {
+            return DivMod(p_a, p_b).first;
+        }
+
+        friend BigInt operator%(const BigInt& p_a, const BigInt& p_b)
+        {
+            return DivMod(p_a, p_b).second;
+        }
+
+        /// <summary>
+        /// Computes the quotient and the remainder together.
+        /// </summary>
+        friend std::pair<BigInt, BigInt> DivMod(const BigInt& p_a, const BigInt& p_b)
+        {
+            if (p_b.IsZero())
+            {
+                throw std::domain_error("Division by zero.");
+            }
+
+            BigInt quotient;
+            BigInt remainder;
+            if (detail::CompareLimbs(p_a.m_limbs.Span(), p_b.m_limbs.Span()) < 0)
+            {
+                remainder = p_a;
+                return { quotient, remainder };
+            }
+
+            if (p_b.m_limbs.size() == 1)
+            {
+                quotient.m_limbs = p_a.m_limbs;
+                const auto rest = detail::DivideLimbsInPlace(quotient.m_limbs.Span(), p_b.m_limbs[0]);
+                if (rest != 0)
+                {
+                    remainder.m_limbs.PushBack(rest);
+                }
+            }
+            else
+            {
+                quotient.m_limbs.Resize(p_a.m_limbs.size() - p_b.m_limbs.size() + 1);
+                remainder.m_limbs.Resize(p_b.m_limbs.size());
+                detail::DivideLimbs(
+                    p_a.m_limbs.Span(), p_b.m_limbs.Span(), quotient.m_limbs.Span(), remainder.m_limbs.Span());
+            }
+
+            quotient.m_limbs.Trim();
+            remainder.m_limbs.Trim();
+            quotient.m_negative = p_a.m_negative != p_b.m_negative && !quotient.IsZero();
+            remainder.m_negative = p_a.m_negative && !remainder.IsZero();
+            return { quotient, remainder };
+        }
+
+        friend std::ostream& operator<<(std::ostream& p_stream, const BigInt& p_value)
+        {
+            return p_stream << p_value.ToString();
+        }
+
+        /// <summary>
+        /// Reads a decimal value, setting the failbit if the next token is not one.
+        /// </summary>
+        friend std::istream& operator>>(std::istream& p_stream, BigInt& p_value)
+        {
+            std::string text;
+            if (p_stream >> text)
+            {
+                try
+                {
+                    p_value = BigInt(std::string_view(text));
+                }
+                catch (const std::invalid_argument&)
+                {
+                    p_stream.setstate(std::ios::failbit);
+                }
+            }
+            return p_stream;
+        }
+
+    private:
+        /// <summary>
+        /// Sets the magnitude to magnitude * p_factor + p_addend.
+        /// </summary>
+        void MultiplyAdd(uint32_t p_factor, uint32_t p_addend)
+        {
+            uint64_t carry = p_addend;
+            for (auto& limb : m_limbs.Span())
+            {
+                carry += uint64_t{ limb } * p_factor;
+                limb = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            if (carry != 0)
+            {
+                m_limbs.PushBack(static_cast<uint32_t>(carry));
+            }
+        }
+
+        /// <summary>
+        /// Adds the magnitude of p_other with the given sign.
+        /// </summary>
+        void AddSigned(const BigInt& p_other, bool p_negative)
+        {
+            if (m_negative == p_negative)
+            {
+                // The sizes are read before resizing since p_other may be this.
+                const auto otherSize = p_other.m_limbs.size();
+                m_limbs.Resize(std::max(m_limbs.size(), otherSize) + 1);
+                detail::AddLimbsAt(m_limbs.Span(), p_other.m_limbs.Span().first(otherSize), 0);
+                m_limbs.Trim();
+                return;
+            }
+
+            // The signs differ, so the smaller magnitude is subtracted from the larger.
+            if (detail::CompareLimbs(m_limbs.Span(), p_other.m_limbs.Span()) >= 0)
+            {
+                detail::SubtractLimbs(m_limbs.Span(), p_other.m_limbs.Span());
+            }
+            else
+            {
+                auto larger = p_other.m_limbs;
+                detail::SubtractLimbs(larger.Span(), m_limbs.Span());
+                m_limbs = std::move(larger);
+                m_negative = p_negative;
+            }
+            m_limbs.Trim();
+            if (IsZero())
+            {
+                m_negative = false;
+            }
+        }
+
+        detail::LimbBuffer m_limbs;
+        bool m_negative{};
+    };
+}
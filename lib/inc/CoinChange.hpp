@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace euler
+{
+    namespace coins
+    {
+        /// <summary>
+        /// Counts the ways to make every amount in [0, p_maxAmount] from unlimited coins of the given denominations,
+        /// where the order of the coins does not matter, and passes each count to a consumer in increasing order of
+        /// amount. This is the usual O(amount * denominations) dynamic program, done in a single sweep.
+        ///
+        /// With the denominations d_1, ..., d_k, let w_j(a) be the ways to make a from the first j of them. Then
+        /// w_j(a) = w_(j-1)(a) + w_j(a - d_j), which only looks d_j amounts back for each denomination. So rather
+        /// than a table over every amount, each denomination keeps a ring buffer of its last d_j counts, and all
+        /// of them advance together one amount at a time. The memory is O(sum of denominations) however large the
+        /// amounts get, and it stays in cache for the whole sweep.
+        /// </summary>
+        /// <remarks>
+        /// The counts grow quickly, e.g. the ways to make 10^6 from the 8 British coins do not fit in 64 bits. Use
+        /// a wider or arbitrary precision T, or a modulus, since T otherwise silently wraps around.
+        /// </remarks>
+        /// <typeparam name="T">The type of the counts. It needs to support +, comparison and construction from 0
+        /// and 1.</typeparam>
+        /// <param name="p_maxAmount">The largest amount to count the ways for.</param>
+        /// <param name="p_denominations">The values of the coins, which must be positive. Each entry is a
+        /// distinct coin, so duplicates count their ways twice.</param>
+        /// <param name="p_consumer">Called as p_consumer(amount, count) for every amount.</param>
+        /// <param name="p_modulus">If set, the counts are reduced modulo this value, which must be positive and
+        /// small enough that twice it still fits in T.</param>
+        template <typename T = uint64_t, typename Consumer>
+        void ForEachWays(
+            uint64_t p_maxAmount,
+            std::span<const uint64_t> p_denominations,
+            Consumer&& p_consumer,
+            std::optional<T> p_modulus = std::nullopt)
+        {
+            if (std::find(p_denominations.begin(), p_denominations.end(), 0) != p_denominations.end())
+            {
+                throw std::invalid_argument("The denominations must be positive.");
+            }
+            if (p_modulus && !(T{ 0 } < *p_modulus))
+            {
+                throw std::invalid_argument("The modulus must be positive.");
+            }
+
+            // The ring buffers are stored back to back. A denomination larger than the largest amount can never
+            // be used, so its buffer is not needed.
+            struct Ring
+            {
+                std::size_t m_start;
+                std::size_t m_size;
+                std::size_t m_position;
+            };
+
+            std::vector<Ring> rings;
+            rings.reserve(p_denominations.size());
+            std::size_t total = 0;
+            for (auto denomination : p_denominations)
+            {
+                if (denomination <= p_maxAmount)
+                {
+                    const auto size = static_cast<std::size_t>(denomination);
+                    rings.push_back(Ring{ total, size, 0 });
+                    total += size;
+                }
+            }
+            std::vector<T> buffer(total, T{ 0 });
+
+            const T one = p_modulus ? T{ 1 } % *p_modulus : T{ 1 };
+            for (uint64_t amount = 0; ; ++amount)
+            {
+                // Only the empty set of coins makes 0.
+                T ways = amount == 0 ? one : T{ 0 };
+                for (auto& ring : rings)
+                {
+                    // The slot holds w_j(amount - d_j), and is overwritten with w_j(amount) for later.
+                    auto& slot = buffer[ring.m_start + ring.m_position];
+                    ways = ways + slot;
+                    if (p_modulus && !(ways < *p_modulus))
+                    {
+                        ways = ways - *p_modulus;
+                    }
+                    slot = ways;
+
+                    if (++ring.m_position == ring.m_size)
+                    {
+                        ring.m_position = 0;
+                    }
+                }
+
+                p_consumer(amount, ways);
+
+                // The check is here rather than in the loop condition so that the largest 64 bit amount does not
+                // wrap around.
+                if (amount == p_maxAmount)
+                {
+                    break;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Counts the ways to make each amount in [0, p_maxAmount], see ForEachWays.
+        /// </summary>
+        /// <returns>The counts indexed by amount.</returns>
+        template <typename T = uint64_t>
+        std::vector<T> WaysTable(
+            uint64_t p_maxAmount,
+            std::span<const uint64_t> p_denominations,
+            std::optional<T> p_modulus = std::nullopt)
+        {
+            std::vector<T> table;
+            table.reserve(static_cast<std::size_t>(p_maxAmount) + 1);
+            ForEachWays<T>(
+                p_maxAmount,
+                p_denominations,
+                [&](uint64_t, const T& p_ways) { table.push_back(p_ways); },
+                p_modulus);
+
+            return table;
+        }
+
+        /// <summary>
+        /// Counts the ways to make each of several amounts in one sweep up to the largest of them, see ForEachWays.
+        /// Only the requested counts are kept, so the memory does not grow with the amounts.
+        /// </summary>
+        /// <returns>The counts in the same order as p_amounts.</returns>
+        template <typename T = uint64_t>
+        std::vector<T> CountWays(
+            std::span<const uint64_t> p_amounts,
+            std::span<const uint64_t> p_denominations,
+            std::optional<T> p_modulus = std::nullopt)
+        {
+            std::vector<T> counts(p_amounts.size(), T{ 0 });
+            if (p_amounts.empty())
+            {
+                return counts;
+            }
+
+            // Visit the amounts in sorted order so that each one is matched as the sweep passes it.
+            std::vector<std::size_t> order(p_amounts.size());
+            std::iota(order.begin(), order.end(), std::size_t{ 0 });
+            std::sort(order.begin(), order.end(), [&](auto p_a, auto p_b) { return p_amounts[p_a] < p_amounts[p_b]; });
+
+            auto next = order.begin();
+            ForEachWays<T>(
+                p_amounts[order.back()],
+                p_denominations,
+                [&](uint64_t p_amount, const T& p_ways)
+                {
+                    for (; next != order.end() && p_amounts[*next] == p_amount; ++next)
+                    {
+                        counts[*next] = p_ways;
+                    }
+                },
+                p_modulus);
+
+            return counts;
+        }
+
+        /// <summary>
+        /// Counts the ways to make a single amount, see ForEachWays.
+        /// </summary>
+        template <typename T = uint64_t>
+        T CountWays(
+            uint64_t p_amount,
+            std::span<const uint64_t> p_denominations,
+            std::optional<T> p_modulus = std::nullopt)
+        {
+            T count{ 0 };
+            ForEachWays<T>(
+                p_amount,
+                p_denominations,
+                [&](uint64_t p_current, const T& p_ways)
+                {
+                    if (p_current == p_amount)
+                    {
+                        count = p_ways;
+                    }
+                },
+                p_modulus);
+
+            return count;
+        }
+    }
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// This class permits iterating over the combinations (the k element subsets) of up to 64 values, with the same
+// interface as PermuteView: the current subset is the visible state and the values left over are the hidden state.
+// A search that does not care about the order of the chosen values visits each subset once here instead of k!
+// times as a partial permutation.
+//
+// The values are sorted via Compare, and a subset is a 64 bit mask with bit i set when the i-th smallest value is
+// chosen. Advance moves to the next larger mask with the same number of bits with Gosper's hack, which is a
+// handful of bit operations, so the subsets are visited in colexicographic order: ordered by their largest value,
+// then their second largest, and so on. Equal values are treated as distinct, so they give repeated subsets.
+//
+// Each subset has a rank in [0, Count()) in that order, given by the combinatorial number system, and like
+// PermuteView a view can be limited to a contiguous range of ranks to split a search across threads.
+template <typename T, typename Compare = std::compare_three_way>
+class CombinationView : private Compare
+{
+    static_assert(
+        std::is_same_v<std::strong_ordering,
+                       decltype(std::declval<Compare>()(std::declval<T>(), std::declval<T>()))>,
+        "T must be strongly ordered via Compare.");
+
+public:
+    // A half open range of ranks, [m_begin, m_end).
+    struct RankRange
+    {
+        uint64_t m_begin;
+        uint64_t m_end;
+    };
+
+    // Create a CombinationView over the data elements choosing k of them.
+    CombinationView(std::span<T> p_data, uint64_t p_k, const Compare& p_compare = Compare())
+        : CombinationView(p_data, p_k, RankRange{ 0, Binomial(p_data.size(), p_k) }, p_compare)
+    {
+    }
+
+    // Create a CombinationView over the data elements choosing k of them, which only visits the combinations with
+    // ranks in the given range. Reset moves the view back to the start of the range.
+    CombinationView(std::span<T> p_data, uint64_t p_k, RankRange p_range, const Compare& p_compare = Compare())
+        : Compare(p_compare),
+          m_state(p_data),
+          m_k(p_k),
+          m_range(p_range)
+    {
+        if (p_data.size() > 64)
+        {
+            throw std::out_of_range("At most 64 values are supported.");
+        }
+        if (p_k > p_data.size())
+        {
+            throw std::out_of_range("The number of values to choose must be in [0, size].");
+        }
+        if (p_range.m_begin >= p_range.m_end || p_range.m_end > Count())
+        {
+            throw std::out_of_range("The rank range must be non-empty and within [0, Count()).");
+        }
+
+        m_sorted.assign(p_data.begin(), p_data.end());
+        std::sort(
+            m_sorted.begin(),
+            m_sorted.end(),
+            [this](const T& p_left, const T& p_right) { return (*static_cast<Compare*>(this))(p_left, p_right) < 0; });
+
+        Reset();
+    }
+
+    // Not copyable to avoid concurrent access issues on the same data without proper synchronization.
+    CombinationView(const CombinationView&) = delete;
+    CombinationView& operator=(const CombinationView&) = delete;
+
+    // Moveable.
+    CombinationView(CombinationView&&) = default;
+    CombinationView& operator=(CombinationView&&) = default;
+
+    bool Advance()
+    {
+        if (m_rank + 1 >= m_range.m_end)
+        {
+            return false;
+        }
+
+        // Gosper's hack: adding the lowest set bit carries through the lowest run of set bits, moving its top bit
+        // up by one, and the rest of the run is moved back down to the bottom.
+        const auto lowest = m_mask & (~m_mask + 1);
+        const auto carried = m_mask + lowest;
+        m_mask = carried | (((carried ^ m_mask) >> 2) >> std::countr_zero(m_mask));
+
+        ++m_rank;
+        m_stale = true;
+        return true;
+    }
+
+    // Move the combination back to the initial state, which is the start of the rank range.
+    void Reset()
+    {
+        Unrank(m_range.m_begin);
+    }
+
+    // Move directly to the combination with the given rank, which must be in the rank range of the view.
+    void Seek(uint64_t p_rank)
+    {
+        if (p_rank < m_range.m_begin || p_rank >= m_range.m_end)
+        {
+            throw std::out_of_range("The rank is outside the range of the view.");
+        }
+
+        Unrank(p_rank);
+    }
+
+    // The number of combinations, C(size, k), which always fits in 64 bits for up to 64 values.
+    uint64_t Count() const
+    {
+        return Binomial(m_state.size(), m_k);
+    }
+
+    // The rank of the current combination in colexicographic order.
+    uint64_t Rank() const
+    {
+        return m_rank;
+    }
+
+    // Splits the ranks of this view into at most p_parts contiguous ranges of nearly equal size, in order. Each
+    // one can be given to a separate view to search it on its own thread, and every one of them needs its own copy
+    // of the data.
+    std::vector<RankRange> Partition(std::size_t p_parts) const
+    {
+        if (p_parts == 0)
+        {
+            throw std::invalid_argument("There must be at least one part.");
+        }
+
+        const auto total = m_range.m_end - m_range.m_begin;
+        const auto parts = std::min<uint64_t>(p_parts, total);
+
+        // The first total % parts ranges take one extra rank.
+        std::vector<RankRange> ranges;
+        ranges.reserve(parts);
+        auto next = m_range.m_begin;
+        for (uint64_t i = 0; i < parts; ++i)
+        {
+            const auto size = total / parts + (i < total % parts ? 1 : 0);
+            ranges.push_back(RankRange{ next, next + size });
+            next += size;
+        }
+
+        return ranges;
+    }
+
+    // The current combination as a mask, with bit i set when the i-th smallest value is chosen.
+    uint64_t Mask() const
+    {
+        return m_mask;
+    }
+
+    // Provides the current view, the chosen values in increasing order.
+    std::span<const T> Current()
+    {
+        Arrange();
+        return std::span<const T>(m_state.data(), m_k);
+    }
+
+    // Given any current state, provides the elements not in the current combination, in increasing order.
+    std::span<const T> Hidden()
+    {
+        Arrange();
+        return std::span<const T>(m_state.data() + m_k, m_state.size() - m_k);
+    }
+
+private:
+    // C(n, k) for n up to 64, all of which fit in 64 bits.
+    static constexpr auto c_binomials = []()
+    {
+        std::array<std::array<uint64_t, 65>, 65> binomials{};
+        for (std::size_t n = 0; n < binomials.size(); ++n)
+        {
+            binomials[n][0] = 1;
+            for (std::size_t k = 1; k <= n; ++k)
+            {
+                binomials[n][k] = binomials[n - 1][k - 1] + (k < n ? binomials[n - 1][k] : 0);
+            }
+        }
+        return binomials;
+    }();
+
+    static uint64_t Binomial(uint64_t p_n, uint64_t p_k)
+    {
+        return p_n <= 64 && p_k <= p_n ? c_binomials[p_n][p_k] : 0;
+    }
+
+    // Moves to the combination with the given rank. In the combinatorial number system the rank is
+    // C(c_k, k) + ... + C(c_1, 1) for the chosen positions c_k > ... > c_1, so the largest position is the largest
+    // c with C(c, k) not above the rank, and the rest follow in turn from what is left of it.
+    void Unrank(uint64_t p_rank)
+    {
+        m_rank = p_rank;
+        m_mask = 0;
+
+        auto position = m_state.size();
+        for (auto remaining = m_k; remaining > 0; --remaining)
+        {
+            do
+            {
+                --position;
+            } while (Binomial(position, remaining) > p_rank);
+
+            m_mask |= uint64_t{ 1 } << position;
+            p_rank -= Binomial(position, remaining);
+        }
+
+        m_stale = true;
+    }
+
+    // Writes the chosen values followed by the rest into the data, when the combination has changed since the last
+    // time. This is only done on request so that advancing stays a few bit operations.
+    void Arrange()
+    {
+        if (!m_stale)
+        {
+            return;
+        }
+
+        std::size_t chosen = 0;
+        std::size_t hidden = m_k;
+        for (std::size_t i = 0; i < m_sorted.size(); ++i)
+        {
+            m_state[(m_mask >> i) & 1 ? chosen++ : hidden++] = m_sorted[i];
+        }
+
+        m_stale = false;
+    }
+
+    // The values, arranged as the chosen values followed by the rest when requested.
+    std::span<T> m_state;
+
+    // The values in sorted order.
+    std::vector<T> m_sorted;
+
+    // The number of values to choose.
+    uint64_t m_k;
+
+    // The ranks this view visits.
+    RankRange m_range;
+
+    // The current combination.
+    uint64_t m_mask = 0;
+
+    // The rank of the current combination.
+    uint64_t m_rank = 0;
+
+    // Whether m_state needs to be arranged for the current combination.
+    bool m_stale = true;
+};
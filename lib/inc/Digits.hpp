@@ -0,0 +1,257 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace euler
+{
+    namespace digits
+    {
+        /// <summary>
+        /// The most digits a 64 bit value can have in a base.
+        /// </summary>
+        template <uint32_t Base = 10>
+        constexpr std::size_t c_maxDigits = []()
+        {
+            static_assert(Base >= 2 && Base <= 256, "A base must be at least 2, and its digits must fit in a byte.");
+
+            std::size_t digits = 1;
+            for (auto value = std::numeric_limits<uint64_t>::max(); value >= Base; value /= Base)
+            {
+                ++digits;
+            }
+            return digits;
+        }();
+
+        /// <summary>
+        /// The powers of a base that fit in 64 bits, starting at Base^0.
+        /// </summary>
+        template <uint32_t Base = 10>
+        constexpr std::array<uint64_t, c_maxDigits<Base>> c_powers = []()
+        {
+            std::array<uint64_t, c_maxDigits<Base>> powers{};
+            powers[0] = 1;
+            for (std::size_t i = 1; i < powers.size(); ++i)
+            {
+                powers[i] = powers[i - 1] * Base;
+            }
+            return powers;
+        }();
+
+        namespace detail
+        {
+            /// <summary>
+            /// The digit count shared by every value of one bit length. The values with a bit length of w lie in
+            /// [2^(w - 1), 2^w), which spans at most a factor of Base, so they have either m_digits digits or one
+            /// more, and they have one more exactly when they exceed m_last.
+            /// </summary>
+            struct CountEntry
+            {
+                uint8_t m_digits;
+                uint64_t m_last;
+            };
+
+            template <uint32_t Base>
+            constexpr std::array<CountEntry, 65> c_countTable = []()
+            {
+                std::array<CountEntry, 65> table{};
+                table[0] = CountEntry{ 1, std::numeric_limits<uint64_t>::max() };
+                for (std::size_t width = 1; width < table.size(); ++width)
+                {
+                    const auto smallest = uint64_t{ 1 } << (width - 1);
+                    uint8_t digits = 1;
+                    while (digits < c_maxDigits<Base> && smallest >= c_powers<Base>[digits])
+                    {
+                        ++digits;
+                    }
+
+                    // The largest value with this many digits, which is capped at the largest 64 bit value when the
+                    // next power of the base does not fit.
+                    const auto last = digits < c_maxDigits<Base>
+                        ? c_powers<Base>[digits] - 1
+                        : std::numeric_limits<uint64_t>::max();
+                    table[width] = CountEntry{ digits, last };
+                }
+                return table;
+            }();
+        }
+
+        /// <summary>
+        /// The number of digits of a value, with 0 having 1 digit. This is a table lookup by bit length followed by
+        /// a single comparison, rather than a loop of divisions.
+        /// </summary>
+        template <uint32_t Base = 10>
+        constexpr std::size_t Count(uint64_t p_value)
+        {
+            const auto& entry = detail::c_countTable<Base>[std::bit_width(p_value)];
+            return entry.m_digits + (p_value > entry.m_last);
+        }
+
+        /// <summary>
+        /// Writes the digits of a value, most significant first, into a buffer. The digits are produced two at a
+        /// time from the remainder by Base^2 which halves the number of 64 bit divisions.
+        /// </summary>
+        /// <param name="p_value">The value to split into digits.</param>
+        /// <param name="p_digits">Receives the digits. Must hold at least Count(p_value) elements, which
+        /// c_maxDigits always does.</param>
+        /// <returns>The number of digits written.</returns>
+        template <uint32_t Base = 10>
+        constexpr std::size_t ToDigits(uint64_t p_value, std::span<uint8_t> p_digits)
+        {
+            constexpr uint64_t c_square = uint64_t{ Base } * Base;
+
+            const auto count = Count<Base>(p_value);
+            auto position = count;
+            while (position >= 2)
+            {
+                const auto pair = static_cast<uint32_t>(p_value % c_square);
+                p_value /= c_square;
+                p_digits[--position] = static_cast<uint8_t>(pair % Base);
+                p_digits[--position] = static_cast<uint8_t>(pair / Base);
+            }
+            if (position == 1)
+            {
+                p_digits[0] = static_cast<uint8_t>(p_value);
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        /// The digits of a value, most significant first, held inline so that extracting them never allocates.
+        /// </summary>
+        template <uint32_t Base = 10>
+        class DigitArray
+        {
+        public:
+            constexpr explicit DigitArray(uint64_t p_value)
+                : m_size(ToDigits<Base>(p_value, m_digits))
+            {
+            }
+
+            constexpr std::span<const uint8_t> Span() const
+            {
+                return std::span<const uint8_t>(m_digits.data(), m_size);
+            }
+
+            constexpr const uint8_t* begin() const
+            {
+                return m_digits.data();
+            }
+
+            constexpr const uint8_t* end() const
+            {
+                return m_digits.data() + m_size;
+            }
+
+            constexpr std::size_t size() const
+            {
+                return m_size;
+            }
+
+            constexpr uint8_t operator[](std::size_t p_index) const
+            {
+                return m_digits[p_index];
+            }
+
+        private:
+            std::array<uint8_t, c_maxDigits<Base>> m_digits{};
+            std::size_t m_size{};
+        };
+
+        /// <summary>
+        /// The digits of a value, most significant first.
+        /// </summary>
+        template <uint32_t Base = 10>
+        constexpr DigitArray<Base> ToDigits(uint64_t p_value)
+        {
+            return DigitArray<Base>(p_value);
+        }
+
+        /// <summary>
+        /// Joins digits, most significant first, into a value.
+        /// </summary>
+        template <typename T = uint64_t, uint32_t Base = 10>
+        constexpr T FromDigits(std::span<const uint8_t> p_digits)
+        {
+            T result{};
+            for (auto digit : p_digits)
+            {
+                result = static_cast<T>(result * Base + digit);
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        /// Reverses the digits of a value, e.g. 1230 becomes 321 in base 10. The result wraps around if it does not
+        /// fit in 64 bits, which only happens for values with c_maxDigits digits.
+        /// </summary>
+        template <uint32_t Base = 10>
+        constexpr uint64_t Reverse(uint64_t p_value)
+        {
+            constexpr uint64_t c_square = uint64_t{ Base } * Base;
+
+            uint64_t reversed = 0;
+            while (p_value >= Base)
+            {
+                const auto pair = static_cast<uint32_t>(p_value % c_square);
+                p_value /= c_square;
+                reversed = reversed * c_square + pair % Base * Base + pair / Base;
+            }
+
+            // The leading digit is left over when the count is odd.
+            return p_value > 0 ? reversed * Base + p_value : reversed;
+        }
+
+        namespace detail
+        {
+            /// <summary>
+            /// The bits of a signature that count one digit, enough to hold c_maxDigits.
+            /// </summary>
+            template <uint32_t Base>
+            constexpr uint32_t c_signatureBits = static_cast<uint32_t>(std::bit_width(c_maxDigits<Base>));
+        }
+
+        /// <summary>
+        /// The multiset of the digits of a value packed into a 64 bit value, so two values are permutations of each
+        /// other's digits exactly when their signatures are equal. Each digit d has a counter at bit
+        /// d * c_signatureBits, and signatures of separate digit groups can be added to combine them.
+        /// </summary>
+        template <uint32_t Base = 10>
+        constexpr uint64_t Signature(uint64_t p_value)
+        {
+            static_assert(Base * detail::c_signatureBits<Base> <= 64, "The digit counters do not fit in 64 bits.");
+
+            uint64_t signature = 0;
+            do
+            {
+                signature += uint64_t{ 1 } << (p_value % Base * detail::c_signatureBits<Base>);
+                p_value /= Base;
+            } while (p_value > 0);
+
+            return signature;
+        }
+
+        /// <summary>
+        /// The signature of a sequence of digits, see Signature(uint64_t).
+        /// </summary>
+        template <uint32_t Base = 10>
+        constexpr uint64_t Signature(std::span<const uint8_t> p_digits)
+        {
+            static_assert(Base * detail::c_signatureBits<Base> <= 64, "The digit counters do not fit in 64 bits.");
+
+            uint64_t signature = 0;
+            for (auto digit : p_digits)
+            {
+                signature += uint64_t{ 1 } << (digit * detail::c_signatureBits<Base>);
+            }
+
+            return signature;
+        }
+    }
+}
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+#include "Sieve.hpp"
+
+namespace euler
+{
+    namespace factor
+    {
+        namespace detail
+        {
+            /// <summary>
+            /// The high 64 bits of the 128 bit product of two 64 bit values.
+            /// </summary>
+            inline uint64_t MulHi(uint64_t p_a, uint64_t p_b)
+            {
+#if defined(__SIZEOF_INT128__)
+                return static_cast<uint64_t>((static_cast<unsigned __int128>(p_a) * p_b) >> 64);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+                return __umulh(p_a, p_b);
+#else
+                const auto aLow = p_a & 0xFFFF'FFFF;
+                const auto aHigh = p_a >> 32;
+                const auto bLow = p_b & 0xFFFF'FFFF;
+                const auto bHigh = p_b >> 32;
+                const auto lowLow = aLow * bLow;
+                const auto highLow = aHigh * bLow;
+                const auto lowHigh = aLow * bHigh;
+                const auto cross = (lowLow >> 32) + (highLow & 0xFFFF'FFFF) + lowHigh;
+                return aHigh * bHigh + (highLow >> 32) + (cross >> 32);
+#endif
+            }
+
+            /// <summary>
+            /// Modular arithmetic for an odd 64 bit modulus in Montgomery form, where a value a is represented as
+            /// aR mod n with R = 2^64. This replaces the 128 by 64 bit division of a modular multiplication with two
+            /// multiplications, which is what makes Miller-Rabin and Pollard-rho fast on full 64 bit inputs.
+            /// </summary>
+            class Montgomery
+            {
+            public:
+                /// <summary>
+                /// Create the arithmetic for a modulus.
+                /// </summary>
+                /// <param name="p_n">The modulus, which must be odd.</param>
+                explicit Montgomery(uint64_t p_n)
+                    : m_n(p_n)
+                {
+                    // Newton's iteration doubles the number of correct low bits of n^-1 mod 2^64 each step, and n is
+                    // its own inverse mod 8 so 3 bits are correct to start.
+                    m_inverse = p_n;
+                    for (auto i = 0; i < 5; ++i)
+                    {
+                        m_inverse *= 2 - p_n * m_inverse;
+                    }
+
+                    // R mod n, then R^2 mod n by doubling it 64 more times.
+                    m_one = (0 - p_n) % p_n;
+                    m_rSquared = m_one;
+                    for (auto i = 0; i < 64; ++i)
+                    {
+                        m_rSquared = Add(m_rSquared, m_rSquared);
+                    }
+                }
+
+                uint64_t Modulus() const
+                {
+                    return m_n;
+                }
+
+                /// <summary>
+                /// The Montgomery form of 1.
+                /// </summary>
+                uint64_t One() const
+                {
+                    return m_one;
+                }
+
+                /// <summary>
+                /// Converts a value into Montgomery form.
+                /// </summary>
+                uint64_t To(uint64_t p_value) const
+                {
+                    return Multiply(p_value % m_n, m_rSquared);
+                }
+
+                /// <summary>
+                /// Converts a value out of Montgomery form.
+                /// </summary>
+                uint64_t From(uint64_t p_value) const
+                {
+                    return Reduce(0, p_value);
+                }
+
+                uint64_t Add(uint64_t p_a, uint64_t p_b) const
+                {
+                    return p_a >= m_n - p_b ? p_a - (m_n - p_b) : p_a + p_b;
+                }
+
+                uint64_t Subtract(uint64_t p_a, uint64_t p_b) const
+                {
+                    return p_a >= p_b ? p_a - p_b : p_a + (m_n - p_b);
+                }
+
+                /// <summary>
+                /// Multiplies two values in Montgomery form.
+                /// </summary>
+                uint64_t Multiply(uint64_t p_a, uint64_t p_b) const
+                {
+                    return Reduce(MulHi(p_a, p_b), p_a * p_b);
+                }
+
+                /// <summary>
+                /// Raises a value in Montgomery form to a power.
+                /// </summary>
+                uint64_t Power(uint64_t p_base, uint64_t p_exponent) const
+                {
+                    auto result = m_one;
+                    while (p_exponent > 0)
+                    {
+                        if (p_exponent & 1)
+                        {
+                            result = Multiply(result, p_base);
+                        }
+                        p_base = Multiply(p_base, p_base);
+                        p_exponent >>= 1;
+                    }
+                    return result;
+                }
+
+            private:
+                /// <summary>
+                /// Computes TR^-1 mod n for the 128 bit value T = high * 2^64 + low, where T < nR.
+                /// </summary>
+                uint64_t Reduce(uint64_t p_high, uint64_t p_low) const
+                {
+                    // m is chosen so that T - mn is divisible by R, and the low words cancel exactly.
+                    const auto m = p_low * m_inverse;
+                    const auto mnHigh = MulHi(m, m_n);
+                    return p_high >= mnHigh ? p_high - mnHigh : p_high + (m_n - mnHigh);
+                }
+
+                /// <summary>
+                /// The modulus.
+                /// </summary>
+                uint64_t m_n;
+
+                /// <summary>
+                /// n^-1 mod 2^64.
+                /// </summary>
+                uint64_t m_inverse{};
+
+                /// <summary>
+                /// R mod n, i.e. 1 in Montgomery form.
+                /// </summary>
+                uint64_t m_one{};
+
+                /// <summary>
+                /// R^2 mod n, used to convert into Montgomery form.
+                /// </summary>
+                uint64_t m_rSquared{};
+            };
+
+            /// <summary>
+            /// The primes that are removed by trial division before the probabilistic methods are used.
+            /// </summary>
+            constexpr std::array<uint64_t, 15> c_smallPrimes{ 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47 };
+
+            /// <summary>
+            /// Finds a non-trivial factor of an odd composite with Pollard's rho, using Brent's cycle detection and
+            /// batching the gcd computations over many steps.
+            /// </summary>
+            inline uint64_t PollardBrent(uint64_t p_n)
+            {
+                const Montgomery mont(p_n);
+                constexpr uint64_t c_batch = 128;
+
+                for (uint64_t c = 1; ; ++c)
+                {
+                    const auto increment = mont.To(c);
+                    auto step = [&](uint64_t p_x) { return mont.Add(mont.Multiply(p_x, p_x), increment); };
+
+                    auto y = mont.To(2);
+                    auto x = y;
+                    auto saved = y;
+                    auto product = mont.One();
+                    uint64_t factor = 1;
+
+                    for (uint64_t length = 1; factor == 1; length <<= 1)
+                    {
+                        x = y;
+                        for (uint64_t i = 0; i < length; ++i)
+                        {
+                            y = step(y);
+                        }
+
+                        for (uint64_t done = 0; done < length && factor == 1; done += c_batch)
+                        {
+                            saved = y;
+                            const auto count = std::min(c_batch, length - done);
+                            for (uint64_t i = 0; i < count; ++i)
+                            {
+                                y = step(y);
+                                product = mont.Multiply(product, mont.Subtract(x, y));
+                            }
+                            factor = std::gcd(product, p_n);
+                        }
+                    }
+
+                    // The batch overshot and the product became 0 mod n. Retrace it one step at a time.
+                    if (factor == p_n)
+                    {
+                        do
+                        {
+                            saved = step(saved);
+                            factor = std::gcd(mont.Subtract(x, saved), p_n);
+                        } while (factor == 1);
+                    }
+
+                    if (factor != p_n)
+                    {
+                        return factor;
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Checks if a 64 bit value is prime. This is a Miller-Rabin test with a set of 7 bases which is known to
+        /// have no strong pseudoprimes below 2^64, so the result is deterministic.
+        /// </summary>
+        inline bool IsPrime(uint64_t p_n)
+        {
+            if (p_n < 2)
+            {
+                return false;
+            }
+            for (auto prime : detail::c_smallPrimes)
+            {
+                if (p_n % prime == 0)
+                {
+                    return p_n == prime;
+                }
+            }
+            if (p_n < detail::c_smallPrimes.back() * detail::c_smallPrimes.back())
+            {
+                return true;
+            }
+
+            const detail::Montgomery mont(p_n);
+            const auto oddPart = (p_n - 1) >> std::countr_zero(p_n - 1);
+            const auto minusOne = mont.Subtract(0, mont.One());
+
+            for (uint64_t base : { 2ull, 325ull, 9375ull, 28178ull, 450775ull, 9780504ull, 1795265022ull })
+            {
+                if (base % p_n == 0)
+                {
+                    continue;
+                }
+
+                auto x = mont.Power(mont.To(base), oddPart);
+                if (x == mont.One() || x == minusOne)
+                {
+                    continue;
+                }
+
+                bool witness = true;
+                for (auto d = oddPart << 1; d != p_n - 1 && witness; d <<= 1)
+                {
+                    x = mont.Multiply(x, x);
+                    witness = x != minusOne;
+                }
+                if (witness)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Finds a non-trivial factor of a composite 64 bit value.
+        /// </summary>
+        /// <param name="p_n">The composite value to split.</param>
+        /// <returns>A factor in (1, p_n), which is not necessarily prime.</returns>
+        inline uint64_t FindFactor(uint64_t p_n)
+        {
+            for (auto prime : detail::c_smallPrimes)
+            {
+                if (p_n % prime == 0)
+                {
+                    return prime;
+                }
+            }
+            return detail::PollardBrent(p_n);
+        }
+
+        /// <summary>
+        /// Factors a 64 bit value into (prime, exponent) pairs in ascending order of prime, without allocating. Small
+        /// primes are removed by trial division, and what remains is split with Pollard-rho until every part passes
+        /// the Miller-Rabin test. 0 and 1 have an empty factorization.
+        /// </summary>
+        inline sieve::Factorization<uint64_t> Factorize(uint64_t p_n)
+        {
+            // A 64 bit value has at most 63 prime factors counted with multiplicity.
+            std::array<uint64_t, 64> primes{};
+            std::size_t primeCount = 0;
+
+            if (p_n > 1)
+            {
+                for (auto prime : detail::c_smallPrimes)
+                {
+                    while (p_n % prime == 0)
+                    {
+                        primes[primeCount++] = prime;
+                        p_n /= prime;
+                    }
+                }
+            }
+
+            std::array<uint64_t, 64> pending{};
+            std::size_t pendingCount = 0;
+            if (p_n > 1)
+            {
+                pending[pendingCount++] = p_n;
+            }
+
+            while (pendingCount > 0)
+            {
+                const auto value = pending[--pendingCount];
+                if (IsPrime(value))
+                {
+                    primes[primeCount++] = value;
+                    continue;
+                }
+
+                const auto factor = detail::PollardBrent(value);
+                pending[pendingCount++] = factor;
+                pending[pendingCount++] = value / factor;
+            }
+
+            std::sort(primes.begin(), primes.begin() + primeCount);
+
+            sieve::Factorization<uint64_t> factors;
+            for (std::size_t i = 0; i < primeCount; )
+            {
+                auto end = i;
+                while (end < primeCount && primes[end] == primes[i])
+                {
+                    ++end;
+                }
+                factors.Push(primes[i], static_cast<uint32_t>(end - i));
+                i = end;
+            }
+
+            return factors;
+        }
+    }
+}
\ No newline at end of file
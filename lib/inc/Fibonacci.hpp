@@ -0,0 +1,323 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "BigInt.hpp"
+
+namespace euler
+{
+    namespace fibonacci
+    {
+        namespace detail
+        {
+            /// <summary>
+            /// Exact arithmetic on a numeric type such as BigInt, or wrapping arithmetic on an unsigned type.
+            /// </summary>
+            template <typename T>
+            struct PlainArithmetic
+            {
+                T Zero() const
+                {
+                    return T(0);
+                }
+
+                T One() const
+                {
+                    return T(1);
+                }
+
+                T Add(const T& p_a, const T& p_b) const
+                {
+                    return p_a + p_b;
+                }
+
+                T Subtract(const T& p_a, const T& p_b) const
+                {
+                    return p_a - p_b;
+                }
+
+                T Multiply(const T& p_a, const T& p_b) const
+                {
+                    return p_a * p_b;
+                }
+            };
+
+            /// <summary>
+            /// Arithmetic modulo a 64 bit value, with the products taken in 128 bits.
+            /// </summary>
+            class ModularArithmetic
+            {
+            public:
+                explicit ModularArithmetic(uint64_t p_modulus)
+                    : m_modulus(p_modulus)
+                {
+                    if (p_modulus == 0)
+                    {
+                        throw std::invalid_argument("The modulus must be positive.");
+                    }
+                }
+
+                uint64_t Zero() const
+                {
+                    return 0;
+                }
+
+                uint64_t One() const
+                {
+                    return 1 % m_modulus;
+                }
+
+                uint64_t Add(uint64_t p_a, uint64_t p_b) const
+                {
+                    return p_a >= m_modulus - p_b ? p_a - (m_modulus - p_b) : p_a + p_b;
+                }
+
+                uint64_t Subtract(uint64_t p_a, uint64_t p_b) const
+                {
+                    return p_a >= p_b ? p_a - p_b : p_a + (m_modulus - p_b);
+                }
+
+                uint64_t Multiply(uint64_t p_a, uint64_t p_b) const
+                {
+#if defined(__SIZEOF_INT128__)
+                    return static_cast<uint64_t>(static_cast<unsigned __int128>(p_a) * p_b % m_modulus);
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+                    // Both values are reduced so the high word is below the modulus, as _udiv128 requires.
+                    uint64_t high{};
+                    const auto low = _umul128(p_a, p_b, &high);
+                    uint64_t remainder{};
+                    _udiv128(high, low, m_modulus, &remainder);
+                    return remainder;
+#else
+                    uint64_t result = 0;
+                    for (; p_b > 0; p_b >>= 1)
+                    {
+                        if (p_b & 1)
+                        {
+                            result = Add(result, p_a);
+                        }
+                        p_a = Add(p_a, p_a);
+                    }
+                    return result;
+#endif
+                }
+
+            private:
+                uint64_t m_modulus;
+            };
+
+            /// <summary>
+            /// Computes (F(n), F(n + 1)) by fast doubling, which walks the bits of n from the top with
+            ///   F(2k) = F(k) (2 F(k + 1) - F(k))
+            ///   F(2k + 1) = F(k)^2 + F(k + 1)^2
+            /// so it only needs O(log n) multiplications.
+            /// </summary>
+            template <typename T, typename Arithmetic>
+            std::pair<T, T> FibonacciPair(uint64_t p_n, const Arithmetic& p_arithmetic)
+            {
+                auto current = p_arithmetic.Zero();
+                auto next = p_arithmetic.One();
+                for (auto bit = std::bit_width(p_n); bit-- > 0; )
+                {
+                    const auto doubled = p_arithmetic.Multiply(
+                        current, p_arithmetic.Subtract(p_arithmetic.Add(next, next), current));
+                    const auto doubledNext = p_arithmetic.Add(
+                        p_arithmetic.Multiply(current, current), p_arithmetic.Multiply(next, next));
+
+                    if ((p_n >> bit) & 1)
+                    {
+                        current = doubledNext;
+                        next = p_arithmetic.Add(doubled, doubledNext);
+                    }
+                    else
+                    {
+                        current = doubled;
+                        next = doubledNext;
+                    }
+                }
+
+                return { current, next };
+            }
+
+            template <typename T>
+            using Matrix3 = std::array<std::array<T, 3>, 3>;
+
+            template <typename T>
+            using Vector3 = std::array<T, 3>;
+
+            template <typename T, typename Arithmetic>
+            Matrix3<T> Multiply(const Matrix3<T>& p_a, const Matrix3<T>& p_b, const Arithmetic& p_arithmetic)
+            {
+                Matrix3<T> result{};
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        auto sum = p_arithmetic.Zero();
+                        for (std::size_t k = 0; k < 3; ++k)
+                        {
+                            sum = p_arithmetic.Add(sum, p_arithmetic.Multiply(p_a[i][k], p_b[k][j]));
+                        }
+                        result[i][j] = sum;
+                    }
+                }
+                return result;
+            }
+
+            template <typename T, typename Arithmetic>
+            Vector3<T> Multiply(const Matrix3<T>& p_a, const Vector3<T>& p_v, const Arithmetic& p_arithmetic)
+            {
+                Vector3<T> result{};
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    auto sum = p_arithmetic.Zero();
+                    for (std::size_t k = 0; k < 3; ++k)
+                    {
+                        sum = p_arithmetic.Add(sum, p_arithmetic.Multiply(p_a[i][k], p_v[k]));
+                    }
+                    result[i] = sum;
+                }
+                return result;
+            }
+
+            /// <summary>
+            /// The even Fibonacci numbers are every third term, E(k) = F(3k), and satisfy
+            /// E(k) = 4 E(k - 1) + E(k - 2). Together with the running sum S(k) = S(k - 1) + E(k) this is a linear
+            /// recurrence on the state (E(k), E(k - 1), S(k)), and this matrix advances it by one step.
+            /// </summary>
+            template <typename T, typename Arithmetic>
+            Matrix3<T> EvenStep(const Arithmetic& p_arithmetic)
+            {
+                const auto zero = p_arithmetic.Zero();
+                const auto one = p_arithmetic.One();
+                const auto four = p_arithmetic.Add(p_arithmetic.Add(one, one), p_arithmetic.Add(one, one));
+                return Matrix3<T>{ {
+                    { four, one, zero },
+                    { one, zero, zero },
+                    { four, one, one } } };
+            }
+
+            /// <summary>
+            /// The state (E(1), E(0), S(1)) = (2, 0, 2) that EvenStep starts from.
+            /// </summary>
+            template <typename T, typename Arithmetic>
+            Vector3<T> EvenStart(const Arithmetic& p_arithmetic)
+            {
+                const auto two = p_arithmetic.Add(p_arithmetic.One(), p_arithmetic.One());
+                return Vector3<T>{ two, p_arithmetic.Zero(), two };
+            }
+
+            template <typename T, typename Arithmetic>
+            T EvenSum(uint64_t p_count, const Arithmetic& p_arithmetic)
+            {
+                if (p_count == 0)
+                {
+                    return p_arithmetic.Zero();
+                }
+
+                // Raise the step to the power count - 1 by squaring and apply it to the start.
+                auto state = EvenStart<T>(p_arithmetic);
+                auto power = EvenStep<T>(p_arithmetic);
+                for (auto remaining = p_count - 1; remaining > 0; remaining >>= 1)
+                {
+                    if (remaining & 1)
+                    {
+                        state = Multiply(power, state, p_arithmetic);
+                    }
+                    power = Multiply(power, power, p_arithmetic);
+                }
+
+                return state[2];
+            }
+        }
+
+        /// <summary>
+        /// Computes the pair (F(n), F(n + 1)) with F(0) = 0 and F(1) = 1, using fast doubling.
+        /// </summary>
+        /// <typeparam name="T">The type of the terms, BigInt for exact values. An unsigned type wraps around, so
+        /// it gives the terms modulo 2^bits.</typeparam>
+        template <typename T = BigInt>
+        std::pair<T, T> FibonacciPair(uint64_t p_n)
+        {
+            return detail::FibonacciPair<T>(p_n, detail::PlainArithmetic<T>());
+        }
+
+        /// <summary>
+        /// Computes F(n) with F(0) = 0 and F(1) = 1, using fast doubling.
+        /// </summary>
+        template <typename T = BigInt>
+        T Fibonacci(uint64_t p_n)
+        {
+            return FibonacciPair<T>(p_n).first;
+        }
+
+        /// <summary>
+        /// Computes F(n) mod p_modulus in O(log n) for any n that fits in 64 bits.
+        /// </summary>
+        inline uint64_t FibonacciMod(uint64_t p_n, uint64_t p_modulus)
+        {
+            return detail::FibonacciPair<uint64_t>(p_n, detail::ModularArithmetic(p_modulus)).first;
+        }
+
+        /// <summary>
+        /// Sums the first p_count even Fibonacci numbers 2, 8, 34, ..., using the matrix form of the recurrence
+        /// E(k) = 4 E(k - 1) + E(k - 2).
+        /// </summary>
+        template <typename T = BigInt>
+        T EvenFibonacciSum(uint64_t p_count)
+        {
+            return detail::EvenSum<T>(p_count, detail::PlainArithmetic<T>());
+        }
+
+        /// <summary>
+        /// Sums the first p_count even Fibonacci numbers modulo p_modulus.
+        /// </summary>
+        inline uint64_t EvenFibonacciSumMod(uint64_t p_count, uint64_t p_modulus)
+        {
+            return detail::EvenSum<uint64_t>(p_count, detail::ModularArithmetic(p_modulus));
+        }
+
+        /// <summary>
+        /// Sums the even Fibonacci numbers that are below a bound. The number of terms is found by a binary search
+        /// over the powers of the step matrix: the powers M^(2^i) are built while the terms stay below the bound,
+        /// and are then applied greedily from the largest, which needs O(log n) matrix products for n terms.
+        /// </summary>
+        /// <param name="p_upTo">The exclusive upper bound on the terms.</param>
+        inline BigInt EvenFibonacciSumBelow(const BigInt& p_upTo)
+        {
+            const detail::PlainArithmetic<BigInt> arithmetic;
+            auto state = detail::EvenStart<BigInt>(arithmetic);
+            if (state[0] >= p_upTo)
+            {
+                return 0;
+            }
+
+            std::vector<detail::Matrix3<BigInt>> powers{ detail::EvenStep<BigInt>(arithmetic) };
+            while (detail::Multiply(powers.back(), state, arithmetic)[0] < p_upTo)
+            {
+                powers.push_back(detail::Multiply(powers.back(), powers.back(), arithmetic));
+            }
+
+            for (auto it = powers.rbegin(); it != powers.rend(); ++it)
+            {
+                auto candidate = detail::Multiply(*it, state, arithmetic);
+                if (candidate[0] < p_upTo)
+                {
+                    state = std::move(candidate);
+                }
+            }
+
+            return state[2];
+        }
+    }
+}
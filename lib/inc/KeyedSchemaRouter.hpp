@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <compare>
+#include <cstddef>
 #include <cstdint>
 #include <format>
 #include <functional>
@@ -74,12 +77,25 @@ namespace euler
 
     namespace detail
     {
+        /// <summary>
+        /// The argument type that a schema spec resolves to. Specs bound from the key take the type of the key
+        /// element, which is only looked up for those specs so that a schema can have more entries than the key.
+        /// </summary>
+        template <typename Key, typename Spec>
+        struct SchemaType
+        {
+            using type = typename Spec::Type;
+        };
+
+        template <typename Key, typename Idx>
+        struct SchemaType<Key, BoundFromKey<Idx>>
+        {
+            using type = std::remove_cvref_t<std::tuple_element_t<Idx::value, Key>>;
+        };
+
         template <typename Key, typename Schema, std::size_t... I>
         auto DeschemifyImpl(std::integer_sequence<std::size_t, I...>)
-            -> std::tuple<std::conditional_t<
-                   mg::is_instance_v<std::remove_cvref_t<std::tuple_element_t<I, Schema>>, detail::BoundFromKey>,
-                   std::remove_cvref_t<std::tuple_element_t<I, Key>>,
-                   typename std::remove_cvref_t<std::tuple_element_t<I, Schema>>::Type>...>;
+            -> std::tuple<typename SchemaType<Key, std::remove_cvref_t<std::tuple_element_t<I, Schema>>>::type...>;
 
         template <typename Key, typename Schema>
         auto Deschemify()
@@ -136,12 +152,65 @@ namespace euler
                     fn = std::forward<Fn>(p_fn),
                     schema = std::forward<Schema>(p_schema)]() -> SchemaExecResult<Fn, Key, Schema>
                 {
-                    return std::apply(fn, mg::tuple_map(schema, resolve));
+                    // The specs are resolved inside a braced initializer, which is evaluated in order, so that
+                    // parameters are requested in the order of the schema.
+                    return std::apply(
+                        [&](auto&&... p_specs)
+                        {
+                            return std::apply(fn, std::tuple<decltype(resolve(p_specs))...>{ resolve(p_specs)... });
+                        },
+                        schema);
                 };
 
                 return exec;
             }
         }
+
+        /// <summary>
+        /// Whether a key element and a lookup element hash the same whenever the map considers them equal. Strings
+        /// are hashed as std::string_view and integers by value, so those match across types, except for integers
+        /// of different signedness which compare after conversion. Any other element only matches its own type.
+        /// </summary>
+        template <typename KeyElement, typename LookupElement>
+        constexpr bool HashCompatibleElement()
+        {
+            if constexpr (
+                std::is_convertible_v<const KeyElement&, std::string_view> &&
+                std::is_convertible_v<const LookupElement&, std::string_view>)
+            {
+                return true;
+            }
+            else if constexpr (std::is_integral_v<KeyElement> && std::is_integral_v<LookupElement>)
+            {
+                return std::is_signed_v<KeyElement> == std::is_signed_v<LookupElement>;
+            }
+            else if constexpr (std::is_same_v<KeyElement, LookupElement>)
+            {
+                return requires(const KeyElement& p_element) { std::hash<KeyElement>{}(p_element); };
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        template <typename Key, typename LookupKey, std::size_t... I>
+        constexpr bool HashCompatibleImpl(std::index_sequence<I...>)
+        {
+            return (HashCompatibleElement<
+                std::remove_cvref_t<std::tuple_element_t<I, Key>>,
+                std::remove_cvref_t<std::tuple_element_t<I, LookupKey>>>() && ...);
+        }
+
+        /// <summary>
+        /// Whether a lookup key of the same size as the key can be routed through the hash index, i.e. every element
+        /// is hash compatible with the matching key element.
+        /// </summary>
+        template <typename Key, typename LookupKey>
+        constexpr bool HashCompatible()
+        {
+            return HashCompatibleImpl<Key, LookupKey>(std::make_index_sequence<std::tuple_size_v<Key>>());
+        }
     }
 
     /// <summary>
@@ -252,6 +321,11 @@ namespace euler
         template <typename LookupKey, typename Fn, typename Schema>
         KeyedSchemaRouter& Add(LookupKey&& p_key, Fn&& p_fn, Schema&& p_schema)
         {
+            if (m_frozen)
+            {
+                throw std::runtime_error("The router is frozen so no more keys can be added.");
+            }
+
             // Use emplace over try_emplace for the following reasons:
             //   * Insertion failures are expected to be very rare and cause an exception anyway so the unnecessary cost
             //     of construction in this case is acceptable.
@@ -342,11 +416,53 @@ namespace euler
             }
         }
 
+        /// <summary>
+        /// Finalizes the router once every key is added. This builds a hash index over the keys so that Route costs
+        /// O(1) rather than a search of the ordered map, which is then only used by PartialMatch. Adding to the
+        /// router afterwards throws. If an element of the key has no std::hash, no index is built and Route keeps
+        /// using the map.
+        /// </summary>
+        void Freeze()
+        {
+            if constexpr (detail::HashCompatible<Key, Key>())
+            {
+                // Keep the load factor at most a half so that probe sequences stay short.
+                const auto capacity = std::bit_ceil(std::max<std::size_t>(2 * m_execs.size(), 1));
+                m_index.assign(capacity, IndexSlot{});
+                m_indexMask = capacity - 1;
+
+                for (const auto& entry : m_execs)
+                {
+                    const auto hash = HeterogenousTupleHash{}(entry.first);
+                    auto slot = static_cast<std::size_t>(hash) & m_indexMask;
+                    while (m_index[slot].m_entry != nullptr)
+                    {
+                        slot = (slot + 1) & m_indexMask;
+                    }
+                    m_index[slot] = IndexSlot{ hash, &entry };
+                }
+            }
+
+            m_frozen = true;
+        }
+
+        /// <summary>
+        /// Whether Freeze has been called on this router.
+        /// </summary>
+        bool IsFrozen() const
+        {
+            return m_frozen;
+        }
+
         /// <summary>
         /// Route to an executable instance previously registered. The lookup key is heterogenous and comparisons will
         /// be done transparently at a per element level. If the key does not exist then an exception is thrown.
         /// Otherwise, the executable logic is returned.
         /// </summary>
+        /// <remarks>Once the router is frozen, the hash index is only used when every element of the lookup key is
+        /// hashed the same as the key element it is compared with: both string like, both integers of the same
+        /// signedness, or both of the same type with a std::hash. Any other lookup key, e.g. a double looked up
+        /// against an integer, is found through the map as before.</remarks>
         /// <typeparam name="LookupKey">The type of the passed in key. Should not usually need to be specified.</typeparam>
         /// <param name="p_key">The key to use for looking up the registered executable.</param>
         /// <returns>The executable logic that this key routes to.</returns>
@@ -359,14 +475,39 @@ namespace euler
             {
                 throw std::runtime_error("The executable could not be found for the given key.");
             }
-
-            auto it = m_execs.find(std::forward<LookupKey>(p_key));
-            if (it == m_execs.end())
+            else
             {
-                throw std::runtime_error("The executable could not be found for the given key.");
-            }
+                if constexpr (detail::HashCompatible<Key, std::remove_cvref_t<LookupKey>>())
+                {
+                    if (m_frozen)
+                    {
+                        // Linear probing from the home slot of the hash until the key or an empty slot is found. The
+                        // stored hashes are compared first so that the entries themselves are only read on a likely
+                        // match.
+                        const auto hash = HeterogenousTupleHash{}(p_key);
+                        for (auto slot = static_cast<std::size_t>(hash) & m_indexMask; ; slot = (slot + 1) & m_indexMask)
+                        {
+                            const auto& indexSlot = m_index[slot];
+                            if (indexSlot.m_entry == nullptr)
+                            {
+                                throw std::runtime_error("The executable could not be found for the given key.");
+                            }
+                            if (indexSlot.m_hash == hash && HeterogenousTupleEqual{}(indexSlot.m_entry->first, p_key))
+                            {
+                                return indexSlot.m_entry->second;
+                            }
+                        }
+                    }
+                }
 
-            return it->second;
+                auto it = m_execs.find(std::forward<LookupKey>(p_key));
+                if (it == m_execs.end())
+                {
+                    throw std::runtime_error("The executable could not be found for the given key.");
+                }
+
+                return it->second;
+            }
         }
 
     private:
@@ -437,6 +578,81 @@ namespace euler
             }
         };
 
+        /// <summary>
+        /// Internal helper struct to hash tuple like objects heterogenously, so that a lookup key hashes the same as
+        /// the stored key it is equal to. Elements convertible to std::string_view are hashed as one, so that
+        /// std::string, string literals and std::string_view agree, and integral elements are hashed by value as 64
+        /// bit integers, so that their width does not matter.
+        /// </summary>
+        struct HeterogenousTupleHash
+        {
+            template <typename T>
+            static uint64_t HashElement(const T& p_element)
+            {
+                if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                {
+                    return std::hash<std::string_view>{}(std::string_view(p_element));
+                }
+                else if constexpr (std::is_integral_v<T>)
+                {
+                    return static_cast<uint64_t>(p_element);
+                }
+                else
+                {
+                    return std::hash<T>{}(p_element);
+                }
+            }
+
+            /// <summary>
+            /// Mixes an element into the running hash with the splitmix64 finalizer, so that the low bits used for
+            /// the slot depend on every bit of every element.
+            /// </summary>
+            static uint64_t Combine(uint64_t p_hash, uint64_t p_element)
+            {
+                auto x = p_hash + p_element + 0x9E3779B97F4A7C15ull;
+                x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+                x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+                return x ^ (x >> 31);
+            }
+
+            template <typename T>
+            uint64_t operator()(const T& p_tuple) const
+            {
+                return std::apply(
+                    [](const auto&... p_elements)
+                    {
+                        uint64_t hash = 0;
+                        ((hash = Combine(hash, HashElement(p_elements))), ...);
+                        return hash;
+                    },
+                    p_tuple);
+            }
+        };
+
+        /// <summary>
+        /// Internal helper struct to compare two tuple like objects of the same size for equality element by element.
+        /// </summary>
+        struct HeterogenousTupleEqual
+        {
+            template <typename T1, typename T2>
+            bool operator()(const T1& p_t1, const T2& p_t2) const
+            {
+                return [&]<std::size_t... I>(std::index_sequence<I...>)
+                {
+                    return ((std::get<I>(p_t1) == std::get<I>(p_t2)) && ...);
+                }(std::make_index_sequence<std::tuple_size_v<T1>>());
+            }
+        };
+
+        /// <summary>
+        /// A slot of the hash index built by Freeze. An empty slot has no entry.
+        /// </summary>
+        struct IndexSlot
+        {
+            uint64_t m_hash{};
+            const std::pair<const Key, std::function<R()>>* m_entry{};
+        };
+
         /// <summary>
         /// The instance that is responsible for resolving unbound parameters in the executables.
         /// </summary>
@@ -449,14 +665,26 @@ namespace euler
 
         /// <summary>
         /// The storage for the executables. A map is used to allow for ordering of the executables
-        /// based on their Key, which will allow for partial lookup later. It does come at a slight
-        /// inefficiency if the full key is known compared to an unordered_map, however for this toy
-        /// example it is fine and illustrates the partial lookup solution.
+        /// based on their Key, which will allow for partial lookup later. Lookups of the full key use
+        /// m_index instead once the router is frozen.
         /// </summary>
         std::map<
             Key,
             std::function<R()>,
             HeterogenousTupleLess> m_execs;
+
+        /// <summary>
+        /// The open addressing hash index over the entries of m_execs, which is built by Freeze. Its
+        /// size is a power of two and m_indexMask maps a hash to its home slot.
+        /// </summary>
+        std::vector<IndexSlot> m_index;
+        std::size_t m_indexMask{};
+
+        /// <summary>
+        /// Whether the router is frozen, in which case it uses m_index for routing and can no longer
+        /// be added to.
+        /// </summary>
+        bool m_frozen{};
     };
 }
 
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+// This class iterates over the permutations of up to 16 distinct small values, each in [0, 16), in the same order
+// as PermuteView: lexicographic order of the first n values, with the rest as the hidden state. Rather than
+// permuting memory, the visible values are packed as 4 bit nibbles in a single 64 bit word, with the value at
+// position i in bits [4i, 4i + 4), and the hidden values are a 16 bit mask with bit v set when v is hidden. Advance
+// only uses bit operations on those two words, so a search over digits never touches memory for its state.
+//
+// The visible and hidden values are available packed, with the hidden values in increasing order, or unpacked
+// into spans. The hidden mask is also available directly, e.g. to check which digits are left in O(1). Values
+// that repeat are not supported here, PermuteView handles those.
+template <std::size_t N>
+class PackedPermuteView
+{
+    static_assert(N >= 1 && N <= 16, "The values must fit in the nibbles of a 64 bit word.");
+
+public:
+    // Create a PackedPermuteView over N distinct values taking n of them.
+    PackedPermuteView(std::span<const uint8_t> p_values, std::size_t p_n = N)
+        : m_n(p_n),
+          m_free(p_n == N ? N - 1 : p_n)
+    {
+        if (p_values.size() != N)
+        {
+            throw std::invalid_argument("The number of values must be N.");
+        }
+        if (p_n == 0 || p_n > N)
+        {
+            throw std::out_of_range("The number of values to take must be in [1, N].");
+        }
+
+        for (auto value : p_values)
+        {
+            if (value >= 16)
+            {
+                throw std::out_of_range("The values must be less than 16.");
+            }
+            if (m_values & (1u << value))
+            {
+                throw std::invalid_argument("The values must be distinct.");
+            }
+            m_values |= 1u << value;
+        }
+
+        Reset();
+    }
+
+    bool Advance()
+    {
+        if (m_free == 0)
+        {
+            return false;
+        }
+
+        // Most of the time the last freely chosen value can be replaced by the next larger hidden value.
+        auto position = m_free - 1;
+        auto state = m_state;
+        auto hidden = m_hidden;
+        auto value = Nibble(state, position);
+        auto larger = hidden & (~0u << (value + 1));
+        if (larger != 0)
+        {
+            const auto next = static_cast<uint32_t>(std::countr_zero(larger));
+            hidden ^= (1u << value) | (1u << next);
+            state ^= uint64_t{ value ^ next } << (4 * position);
+            Store(state, hidden);
+            return true;
+        }
+
+        // Otherwise return values to the hidden state from the end until one of them can be replaced by a larger
+        // hidden value, and refill the positions after it with the smallest hidden values in increasing order.
+        hidden |= 1u << value;
+        while (position > 0)
+        {
+            --position;
+            value = Nibble(state, position);
+            hidden |= 1u << value;
+            larger = hidden & (~0u << (value + 1));
+            if (larger != 0)
+            {
+                auto next = static_cast<uint32_t>(std::countr_zero(larger));
+                hidden ^= 1u << next;
+
+                state = (state & ((uint64_t{ 1 } << (4 * position)) - 1)) | (uint64_t{ next } << (4 * position));
+                while (++position < m_free)
+                {
+                    next = static_cast<uint32_t>(std::countr_zero(hidden));
+                    hidden &= hidden - 1;
+                    state |= uint64_t{ next } << (4 * position);
+                }
+
+                Store(state, hidden);
+                return true;
+            }
+        }
+
+        // The view is left at the last permutation.
+        return false;
+    }
+
+    // Move the permutation back to the initial state, which is sorted.
+    void Reset()
+    {
+        uint64_t state = 0;
+        auto hidden = m_values;
+        for (std::size_t position = 0; position < m_free; ++position)
+        {
+            state |= uint64_t{ static_cast<uint32_t>(std::countr_zero(hidden)) } << (4 * position);
+            hidden &= hidden - 1;
+        }
+        Store(state, hidden);
+    }
+
+    // The visible values, packed with the value at position i in bits [4i, 4i + 4).
+    uint64_t CurrentPacked() const
+    {
+        return m_state;
+    }
+
+    // The hidden values in increasing order, packed like CurrentPacked starting from the first hidden value.
+    uint64_t HiddenPacked() const
+    {
+        uint64_t packed = 0;
+        std::size_t position = 0;
+        for (auto hidden = HiddenMask(); hidden != 0; hidden &= hidden - 1)
+        {
+            packed |= uint64_t{ static_cast<uint32_t>(std::countr_zero(hidden)) } << (4 * position++);
+        }
+        return packed;
+    }
+
+    // The whole permutation, packed like CurrentPacked.
+    uint64_t Packed() const
+    {
+        return m_n == N ? m_state : m_state | (HiddenPacked() << (4 * m_n));
+    }
+
+    // The hidden values as a mask with bit v set when v is hidden.
+    uint32_t HiddenMask() const
+    {
+        return m_n == N ? 0 : m_hidden;
+    }
+
+    // Provides the current view, unpacked.
+    std::span<const uint8_t> Current()
+    {
+        Unpack();
+        return std::span<const uint8_t>(m_unpacked.data(), m_n);
+    }
+
+    // Given any current state, provides the elements not in the current permutation, unpacked.
+    std::span<const uint8_t> Hidden()
+    {
+        Unpack();
+        return std::span<const uint8_t>(m_unpacked.data() + m_n, N - m_n);
+    }
+
+private:
+    static uint32_t Nibble(uint64_t p_state, std::size_t p_index)
+    {
+        return static_cast<uint32_t>(p_state >> (4 * p_index)) & 0xF;
+    }
+
+    // Stores a new state. When all the values are visible the last one is the only value left in the hidden mask,
+    // and it is written to the last position.
+    void Store(uint64_t p_state, uint32_t p_hidden)
+    {
+        if (m_free < m_n)
+        {
+            const auto last = static_cast<uint32_t>(std::countr_zero(p_hidden));
+            p_state = (p_state & ((uint64_t{ 1 } << (4 * m_free)) - 1)) | (uint64_t{ last } << (4 * m_free));
+        }
+
+        m_state = p_state;
+        m_hidden = p_hidden;
+    }
+
+    void Unpack()
+    {
+        for (std::size_t i = 0; i < m_n; ++i)
+        {
+            m_unpacked[i] = static_cast<uint8_t>(Nibble(m_state, i));
+        }
+
+        auto position = m_n;
+        for (auto hidden = HiddenMask(); hidden != 0; hidden &= hidden - 1)
+        {
+            m_unpacked[position++] = static_cast<uint8_t>(std::countr_zero(hidden));
+        }
+    }
+
+    // The number of values to include in the visible state.
+    std::size_t m_n;
+
+    // The number of visible positions that are chosen freely, since when all the values are visible the last one
+    // is determined by the rest.
+    std::size_t m_free;
+
+    // All the values as a mask.
+    uint32_t m_values{};
+
+    // The visible values.
+    uint64_t m_state{};
+
+    // The values not in the free positions as a mask.
+    uint32_t m_hidden{};
+
+    // The values unpacked for Current and Hidden.
+    std::array<uint8_t, N> m_unpacked{};
+};
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include "Digits.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define EULER_PALINDROME_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC allows any intrinsic in any function, so no per function target is needed.
+#define EULER_PALINDROME_TARGET(x)
+#else
+#define EULER_PALINDROME_TARGET(x) __attribute__((target(x)))
+#endif
+#endif
+
+namespace euler
+{
+    namespace palindrome
+    {
+        namespace detail
+        {
+            /// <summary>
+            /// Every value below this is split into two 9 digit halves that are reversed independently.
+            /// </summary>
+            constexpr uint64_t c_maxSplit = 1'000'000'000'000'000'000ull;
+
+            /// <summary>
+            /// The reversal of every 4 digit group including leading zeros, e.g. 12 (i.e. 0012) maps to 2100. There
+            /// is one unused entry at the end so that a 32 bit gather of the last group stays inside the table.
+            /// </summary>
+            constexpr std::array<uint16_t, 10001> c_reversedQuads = []()
+            {
+                std::array<uint16_t, 10001> quads{};
+                for (uint16_t i = 0; i < quads.size(); ++i)
+                {
+                    quads[i] = static_cast<uint16_t>(i % 10 * 1000 + i / 10 % 10 * 100 + i / 100 % 10 * 10 + i / 1000);
+                }
+                return quads;
+            }();
+
+            /// <summary>
+            /// Reverses a value below 10^9 as 9 digits including leading zeros, e.g. 1230 becomes 32'100'000. Digits
+            /// are consumed four at a time through a lookup table, so the dependency chain is only two divisions.
+            /// </summary>
+            constexpr uint64_t Reverse9(uint64_t p_value)
+            {
+                const auto upper = p_value / 10000;
+                const auto top = upper / 10000;
+                return (c_reversedQuads[p_value - upper * 10000] * 10000ull + c_reversedQuads[upper - top * 10000]) * 10
+                    + top;
+            }
+
+            /// <summary>
+            /// The pieces a value below c_maxSplit is checked with. With n = high * 10^9 + low, reversing all 18
+            /// digits including leading zeros gives Reverse9(low) * 10^9 + Reverse9(high). That is the reversal of
+            /// the d digits of n scaled by 10^(18 - d), so n is a palindrome exactly when it equals the target
+            /// n * 10^(18 - d).
+            /// </summary>
+            struct Split
+            {
+                uint64_t m_high;
+                uint64_t m_low;
+                uint64_t m_target;
+            };
+
+            constexpr Split SplitValue(uint64_t p_value)
+            {
+                return Split{
+                    p_value / 1'000'000'000,
+                    p_value % 1'000'000'000,
+                    p_value * digits::c_powers<>[18 - digits::Count(p_value)] };
+            }
+
+            /// <summary>
+            /// Checks values that are too large to split, one digit at a time.
+            /// </summary>
+            constexpr bool IsLargePalindrome(uint64_t p_value)
+            {
+                const auto count = digits::Count(p_value);
+                for (std::size_t i = 0; i < count / 2; ++i)
+                {
+                    if (p_value / digits::c_powers<>[i] % 10 != p_value / digits::c_powers<>[count - 1 - i] % 10)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /// <summary>
+            /// The signature of every batch kernel.
+            /// </summary>
+            using Kernel = void (*)(std::span<const int64_t>, std::span<bool>);
+        }
+
+        /// <summary>
+        /// Checks if a value is a decimal palindrome. Negative values are never palindromes.
+        /// </summary>
+        constexpr bool IsPalindrome(int64_t p_value)
+        {
+            if (p_value < 0)
+            {
+                return false;
+            }
+
+            const auto value = static_cast<uint64_t>(p_value);
+            if (value >= detail::c_maxSplit)
+            {
+                return detail::IsLargePalindrome(value);
+            }
+
+            const auto split = detail::SplitValue(value);
+            return detail::Reverse9(split.m_low) * 1'000'000'000 + detail::Reverse9(split.m_high) == split.m_target;
+        }
+
+        namespace detail
+        {
+            inline void ScalarKernel(std::span<const int64_t> p_values, std::span<bool> p_results)
+            {
+                // Check several values per iteration so that their independent digit chains can overlap.
+                std::size_t i = 0;
+                for (; i + 4 <= p_values.size(); i += 4)
+                {
+                    p_results[i] = IsPalindrome(p_values[i]);
+                    p_results[i + 1] = IsPalindrome(p_values[i + 1]);
+                    p_results[i + 2] = IsPalindrome(p_values[i + 2]);
+                    p_results[i + 3] = IsPalindrome(p_values[i + 3]);
+                }
+                for (; i < p_values.size(); ++i)
+                {
+                    p_results[i] = IsPalindrome(p_values[i]);
+                }
+            }
+
+#ifdef EULER_PALINDROME_X86
+            /// <summary>
+            /// Divides each unsigned 32 bit lane by a constant as (x * magic) >> shift. The multiply only exists
+            /// for the even lanes, so the odd lanes are shifted down, multiplied separately and blended back.
+            /// </summary>
+            EULER_PALINDROME_TARGET("avx2")
+            inline __m256i DivideAvx2(__m256i p_values, __m256i p_magic, int p_shift)
+            {
+                const auto even = _mm256_srli_epi64(_mm256_mul_epu32(p_values, p_magic), p_shift);
+                const auto odd = _mm256_srli_epi64(
+                    _mm256_mul_epu32(_mm256_srli_epi64(p_values, 32), p_magic), p_shift - 32);
+                return _mm256_blend_epi32(even, odd, 0b1010'1010);
+            }
+
+            /// <summary>
+            /// The AVX2 equivalent of Reverse9 over 8 lanes of 32 bits. x / 10000 is (x * 0xD1B71759) >> 45, which
+            /// is exact for every 32 bit x, and the 4 digit groups are gathered from c_reversedQuads.
+            /// </summary>
+            EULER_PALINDROME_TARGET("avx2")
+            inline __m256i Reverse9Avx2(__m256i p_values)
+            {
+                const auto magic = _mm256_set1_epi32(static_cast<int>(0xD1B7'1759u));
+                const auto tenThousand = _mm256_set1_epi32(10000);
+                const auto quadMask = _mm256_set1_epi32(0xFFFF);
+                const auto quads = reinterpret_cast<const int*>(c_reversedQuads.data());
+
+                const auto upper = DivideAvx2(p_values, magic, 45);
+                const auto top = DivideAvx2(upper, magic, 45);
+                const auto lowIndex = _mm256_sub_epi32(p_values, _mm256_mullo_epi32(upper, tenThousand));
+                const auto highIndex = _mm256_sub_epi32(upper, _mm256_mullo_epi32(top, tenThousand));
+                const auto lowQuad = _mm256_and_si256(_mm256_i32gather_epi32(quads, lowIndex, 2), quadMask);
+                const auto highQuad = _mm256_and_si256(_mm256_i32gather_epi32(quads, highIndex, 2), quadMask);
+
+                const auto reversed = _mm256_add_epi32(_mm256_mullo_epi32(lowQuad, tenThousand), highQuad);
+                return _mm256_add_epi32(
+                    _mm256_add_epi32(_mm256_slli_epi32(reversed, 3), _mm256_slli_epi32(reversed, 1)), top);
+            }
+
+            /// <summary>
+            /// The low 64 bits of the product of each pair of 64 bit lanes, built from three 32 bit multiplies.
+            /// </summary>
+            EULER_PALINDROME_TARGET("avx2")
+            inline __m256i MultiplyAvx2(__m256i p_a, __m256i p_b)
+            {
+                const auto cross = _mm256_add_epi64(
+                    _mm256_mul_epu32(_mm256_srli_epi64(p_a, 32), p_b),
+                    _mm256_mul_epu32(p_a, _mm256_srli_epi64(p_b, 32)));
+                return _mm256_add_epi64(_mm256_mul_epu32(p_a, p_b), _mm256_slli_epi64(cross, 32));
+            }
+
+            /// <summary>
+            /// Checks 4 values per iteration entirely in vector registers, following SplitValue:
+            /// - The halves come from a double precision estimate of n / 10^9 that is corrected by at most one.
+            /// - Both halves of all 4 values are reversed together in the 8 lanes of one register.
+            /// - The digit count comes from the exponent of the same double. The bit length w gives the estimate
+            ///   (w * 1233) >> 12 (1233 / 4096 is just above log10(2)) which is off by at most one, and it is
+            ///   corrected with a power of 10 gathered from digits::c_powers.
+            /// Values that cannot be split are zeroed for the vector work and checked by IsPalindrome instead.
+            /// </summary>
+            EULER_PALINDROME_TARGET("avx2")
+            inline void Avx2Kernel(std::span<const int64_t> p_values, std::span<bool> p_results)
+            {
+                const auto zero = _mm256_setzero_si256();
+                const auto one = _mm256_set1_epi64x(1);
+                const auto billion = _mm256_set1_epi64x(1'000'000'000);
+                const auto maxLow = _mm256_set1_epi64x(999'999'999);
+                const auto maxValue = _mm256_set1_epi64x(static_cast<int64_t>(c_maxSplit - 1));
+                const auto pow10 = reinterpret_cast<const long long*>(digits::c_powers<>.data());
+
+                // A 32 bit value x placed in the mantissa of 2^52 gives the double 2^52 + x exactly.
+                const auto exponentBits = _mm256_set1_epi64x(0x4330'0000'0000'0000);
+                const auto two52 = _mm256_set1_pd(4'503'599'627'370'496.0);
+                const auto two32 = _mm256_set1_pd(4'294'967'296.0);
+                const auto inverseBillion = _mm256_set1_pd(1e-9);
+
+                std::size_t i = 0;
+                for (; i + 4 <= p_values.size(); i += 4)
+                {
+                    auto values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_values.data() + i));
+                    const auto unsplit = _mm256_or_si256(
+                        _mm256_cmpgt_epi64(zero, values), _mm256_cmpgt_epi64(values, maxValue));
+                    values = _mm256_andnot_si256(unsplit, values);
+
+                    const auto lowWord = _mm256_castsi256_pd(
+                        _mm256_or_si256(_mm256_blend_epi32(values, zero, 0b1010'1010), exponentBits));
+                    const auto highWord = _mm256_castsi256_pd(
+                        _mm256_or_si256(_mm256_srli_epi64(values, 32), exponentBits));
+                    const auto approximate = _mm256_add_pd(
+                        _mm256_mul_pd(_mm256_sub_pd(highWord, two52), two32), _mm256_sub_pd(lowWord, two52));
+
+                    auto high = _mm256_cvtepu32_epi64(_mm256_cvttpd_epi32(_mm256_mul_pd(approximate, inverseBillion)));
+                    auto low = _mm256_sub_epi64(values, _mm256_mul_epu32(high, billion));
+                    const auto under = _mm256_cmpgt_epi64(zero, low);
+                    const auto over = _mm256_cmpgt_epi64(low, maxLow);
+                    high = _mm256_add_epi64(
+                        _mm256_sub_epi64(high, _mm256_and_si256(under, one)), _mm256_and_si256(over, one));
+                    low = _mm256_sub_epi64(
+                        _mm256_add_epi64(low, _mm256_and_si256(under, billion)), _mm256_and_si256(over, billion));
+
+                    // Reverse9(low) ends up in the even lanes and Reverse9(high) in the odd lanes.
+                    const auto halves = Reverse9Avx2(_mm256_or_si256(low, _mm256_slli_epi64(high, 32)));
+                    auto reversed = _mm256_add_epi64(_mm256_mul_epu32(halves, billion), _mm256_srli_epi64(halves, 32));
+
+                    // The exponent gives the bit width, with 0 clamped to a width of 0. Rounding to the nearest
+                    // double can only round up to a power of 2, and there is never a power of 10 in between.
+                    const auto exponent = _mm256_srli_epi64(_mm256_castpd_si256(approximate), 52);
+                    const auto width = _mm256_max_epi32(_mm256_sub_epi64(exponent, _mm256_set1_epi64x(1022)), zero);
+                    const auto estimate = _mm256_srli_epi64(_mm256_mul_epu32(width, _mm256_set1_epi64x(1233)), 12);
+                    const auto belowEstimate = _mm256_cmpgt_epi64(_mm256_i64gather_epi64(pow10, estimate, 8), values);
+                    const auto scale =
+                        _mm256_i64gather_epi64(pow10, _mm256_sub_epi64(_mm256_set1_epi64x(18), estimate), 8);
+
+                    // The target is n * 10^(18 - d) where d is the estimate or one more. Rather than dividing the
+                    // scale by 10 when it is one more, the reversal is multiplied by 10, which cannot overflow.
+                    const auto reversedTimes10 =
+                        _mm256_add_epi64(_mm256_slli_epi64(reversed, 3), _mm256_slli_epi64(reversed, 1));
+                    reversed = _mm256_blendv_epi8(reversedTimes10, reversed, belowEstimate);
+
+                    const auto equal = _mm256_cmpeq_epi64(reversed, MultiplyAvx2(values, scale));
+                    const auto mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal));
+                    for (std::size_t j = 0; j < 4; ++j)
+                    {
+                        p_results[i + j] = (mask >> j) & 1;
+                    }
+
+                    if (!_mm256_testz_si256(unsplit, unsplit))
+                    {
+                        for (std::size_t j = 0; j < 4; ++j)
+                        {
+                            p_results[i + j] = IsPalindrome(p_values[i + j]);
+                        }
+                    }
+                }
+
+                ScalarKernel(p_values.subspan(i), p_results.subspan(i));
+            }
+
+            /// <summary>
+            /// Checks if the processor and the operating system support AVX2.
+            /// </summary>
+            inline bool SupportsAvx2()
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                std::array<int, 4> info{};
+                __cpuid(info.data(), 0);
+                const auto maxLeaf = info[0];
+
+                __cpuid(info.data(), 1);
+                const bool osxsave = (info[2] >> 27) & 1;
+                const bool avx = (info[2] >> 28) & 1;
+                if (maxLeaf < 7 || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+                {
+                    return false;
+                }
+
+                __cpuidex(info.data(), 7, 0);
+                return (info[1] >> 5) & 1;
+#else
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+#endif
+            }
+#endif
+
+            /// <summary>
+            /// Selects the batch kernel for this processor. The detection is only done once.
+            /// </summary>
+            inline Kernel SelectKernel()
+            {
+#ifdef EULER_PALINDROME_X86
+                static const Kernel kernel = SupportsAvx2() ? Avx2Kernel : ScalarKernel;
+                return kernel;
+#else
+                return ScalarKernel;
+#endif
+            }
+        }
+
+        /// <summary>
+        /// Checks a batch of values for being decimal palindromes. Each value is split into two 9 digit halves that
+        /// are reversed 4 digits at a time, see detail::Split, in vector lanes if the processor supports AVX2 and
+        /// with a scalar kernel otherwise. The choice is made at runtime so the binary does not need to target a
+        /// specific instruction set.
+        /// </summary>
+        /// <param name="p_values">The values to check.</param>
+        /// <param name="p_results">Receives whether the value at the same index is a palindrome. Must be at least
+        /// as large as p_values.</param>
+        inline void ArePalindromes(std::span<const int64_t> p_values, std::span<bool> p_results)
+        {
+            if (p_results.size() < p_values.size())
+            {
+                throw std::invalid_argument("The results must be at least as large as the values.");
+            }
+
+            detail::SelectKernel()(p_values, p_results.subspan(0, p_values.size()));
+        }
+    }
+}
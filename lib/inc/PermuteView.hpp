@@ -2,14 +2,78 @@
 
 #include <algorithm>
 #include <compare>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <cstdlib>
+#include <limits>
 #include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+// A block of permutations in a caller provided buffer, laid out as a structure of arrays: row p holds the value at
+// position p of every permutation in the block, so the same position of consecutive permutations is contiguous.
+// The rows cover the visible positions followed by the hidden ones.
+template <typename T>
+class PermuteBlock
+{
+public:
+    // Create a block over a buffer for permutations of p_positions values, which holds as many permutations as
+    // fit in the buffer.
+    PermuteBlock(std::span<T> p_storage, std::size_t p_positions)
+        : m_storage(p_storage),
+          m_positions(p_positions),
+          m_capacity(p_positions == 0 ? 0 : p_storage.size() / p_positions),
+          m_size(0)
+    {
+        if (m_capacity == 0)
+        {
+            throw std::invalid_argument("The buffer must hold at least one permutation.");
+        }
+    }
+
+    // The number of values in each permutation.
+    std::size_t Positions() const
+    {
+        return m_positions;
+    }
+
+    // The most permutations the block holds.
+    std::size_t Capacity() const
+    {
+        return m_capacity;
+    }
+
+    // The number of permutations in the block.
+    std::size_t Size() const
+    {
+        return m_size;
+    }
+
+    // The value at position p_position of every permutation in the block.
+    std::span<const T> Row(std::size_t p_position) const
+    {
+        return m_storage.subspan(p_position * m_capacity, m_size);
+    }
+
+    // The value at a position of one permutation in the block.
+    const T& operator()(std::size_t p_position, std::size_t p_permutation) const
+    {
+        return m_storage[p_position * m_capacity + p_permutation];
+    }
+
+private:
+    template <typename, typename>
+    friend class PermuteView;
+
+    std::span<T> m_storage;
+    std::size_t m_positions;
+    std::size_t m_capacity;
+    std::size_t m_size;
+};
+
 // This class permits iterating over the permutations of a set of values from some domain.
 // The value type, T, can be any strongly ordered type which is defined by the the Compare
 // type parameter. Typical usage for this class would be to get the current state of the
@@ -20,6 +84,19 @@
 // permutations does not exist (i.e. all permutations of size M from set of N, where M < N) and
 // therefore there is also no way to easily access the hidden state or left over elements for
 // any given state.
+//
+// NextBlock writes many permutations at once into a PermuteBlock, so a consumer can process them together, e.g.
+// with SIMD across permutations.
+//
+// The values may contain duplicates, i.e. equal under Compare, in which case each distinct arrangement of the
+// visible values is visited exactly once. Compared to making the values unique, this saves a factor of the
+// product of the factorials of the multiplicities.
+//
+// The permutations are visited in lexicographic order of the visible values, so each one has a rank in
+// [0, Count()). Without duplicates this is the Lehmer code, i.e. the digits in the falling factorial number
+// system, and with them it counts the distinct arrangements that come before. A view can be
+// limited to a contiguous range of ranks, which allows a search to be split across threads with Partition while
+// every part still visits its permutations in a deterministic order.
 template <typename T, typename Compare = std::compare_three_way>
 class PermuteView : private Compare
 {
@@ -29,9 +106,15 @@ class PermuteView : private Compare
         "T must be strongly ordered via Compare.");
 
 public:
-    // Create a PermuteView over all the data elements. i.e. there are n! states from this.
-    // The values are assumed to be unique. This requirement could be relaxed if necessary
-    // but if so, should include proper handling to ensure stability.
+    // A half open range of ranks, [m_begin, m_end).
+    struct RankRange
+    {
+        uint64_t m_begin;
+        uint64_t m_end;
+    };
+
+    // Create a PermuteView over all the data elements. i.e. there are n! states from this when the values are
+    // unique, and fewer when some of them are equal.
     PermuteView(std::span<T> p_data, const Compare& p_compare = Compare())
         : PermuteView(p_data, p_data.size(), p_compare)
     {
@@ -39,21 +122,52 @@ public:
 
     // Create a PermuteView over the data elements only taking n
     PermuteView(std::span<T> p_data, uint64_t p_n, const Compare& p_compare = Compare())
+        : PermuteView(p_data, p_n, RankRange{ 0, std::numeric_limits<uint64_t>::max() }, p_compare)
+    {
+    }
+
+    // Create a PermuteView over the data elements only taking n, which only visits the permutations with ranks
+    // in the given range. Reset moves the view back to the start of the range rather than the sorted state.
+    PermuteView(std::span<T> p_data, uint64_t p_n, RankRange p_range, const Compare& p_compare = Compare())
         : Compare(p_compare),
           m_state(p_data),
           m_n(p_n),
-          m_lastHiddenStateIdxUsed(-1)
+          m_lastHiddenStateIdxUsed(-1),
+          m_range(p_range),
+          m_rank(0)
     {
-        Reset();
+        if (p_n == 0 || p_n > p_data.size())
+        {
+            throw std::out_of_range("The number of values to take must be in [1, size].");
+        }
 
-        auto firstDuplicate = std::adjacent_find(
-            m_state.begin(),
-            m_state.end(),
-            [this](const T& p_a, const T& p_b) { return (*static_cast<Compare*>(this))(p_a, p_b) == 0; });
-        if (firstDuplicate != m_state.end())
+        // Equal values are adjacent once sorted, which gives the multiplicity of each distinct value.
+        Sort();
+        for (std::size_t i = 0; i < m_state.size(); ++i)
         {
-            throw std::runtime_error("Duplicates in the dataset are not supported at the moment.");
+            if (i > 0 && (*static_cast<Compare*>(this))(m_state[i - 1], m_state[i]) == 0)
+            {
+                ++m_multiplicities.back();
+                m_hasDuplicates = true;
+            }
+            else
+            {
+                m_values.push_back(m_state[i]);
+                m_multiplicities.push_back(1);
+            }
         }
+
+        if (p_range.m_begin >= p_range.m_end ||
+            (p_range.m_end != std::numeric_limits<uint64_t>::max() && p_range.m_end > Count()))
+        {
+            throw std::out_of_range("The rank range must be non-empty and within [0, Count()).");
+        }
+
+        m_saved.assign(m_state.begin(), m_state.end());
+        m_remaining.resize(m_multiplicities.size());
+        m_ways.reserve(m_n + 1);
+
+        Reset();
     }
 
     // Not copyable to avoid concurrent access issues on the same data without proper synchronization.
@@ -66,6 +180,322 @@ public:
 
     bool Advance()
     {
+        if (m_rank + 1 >= m_range.m_end || !AdvanceState())
+        {
+            return false;
+        }
+
+        ++m_rank;
+        return true;
+    }
+
+    // Move the permutation back to the initial state, which is the start of the rank range.
+    void Reset()
+    {
+        Sort();
+        m_lastHiddenStateIdxUsed = -1;
+        m_rank = 0;
+        m_rankStale = false;
+        m_blockExhausted = false;
+
+        if (m_range.m_begin > 0)
+        {
+            Unrank(m_range.m_begin);
+        }
+    }
+
+    // Move directly to the permutation with the given rank, which must be in the rank range of the view.
+    void Seek(uint64_t p_rank)
+    {
+        if (p_rank < m_range.m_begin || p_rank >= m_range.m_end || p_rank >= Count())
+        {
+            throw std::out_of_range("The rank is outside the range of the view.");
+        }
+
+        Sort();
+        Unrank(p_rank);
+        m_blockExhausted = false;
+    }
+
+    // Advance to the next permutation whose first p_depth visible values differ from the current ones, skipping
+    // every permutation that shares the prefix. This lets a search prune a whole subtree at once instead of
+    // advancing through its (n - depth)! states. Returns false, leaving the view unchanged, if there is no such
+    // permutation in the rank range.
+    bool SkipPrefix(uint64_t p_depth)
+    {
+        if (p_depth > m_n)
+        {
+            throw std::out_of_range("The prefix cannot be longer than the visible state.");
+        }
+        if (p_depth == 0)
+        {
+            // Every permutation shares the empty prefix.
+            return false;
+        }
+
+        // Keep the state so that the view can be left unchanged if there is no next prefix.
+        const auto lastHiddenStateIdxUsed = m_lastHiddenStateIdxUsed;
+        std::copy(m_state.begin(), m_state.end(), m_saved.begin());
+
+        const auto suffix = m_state.begin() + p_depth;
+        const auto visibleEnd = m_state.begin() + m_n;
+
+        // Arrange the values after the prefix into the last permutation that shares it, which has the largest of
+        // them in descending order in the visible state and the rest sorted in the hidden state, and advance once
+        // from there.
+        SortRange(suffix, m_state.end());
+        std::rotate(suffix, m_state.end() - (visibleEnd - suffix), m_state.end());
+        std::reverse(suffix, visibleEnd);
+        m_lastHiddenStateIdxUsed = -1;
+
+        // The rank is only needed here to stay within a rank range, in which case Count() fits and the rank is
+        // kept up to date. Otherwise it is left to Rank() to work out, since it may not even fit in 64 bits.
+        auto advanced = AdvanceState();
+        if (advanced && m_range.m_end != std::numeric_limits<uint64_t>::max())
+        {
+            const auto rank = RankOfState();
+            advanced = rank < m_range.m_end;
+            if (advanced)
+            {
+                m_rank = rank;
+            }
+        }
+        else if (advanced)
+        {
+            m_rankStale = true;
+        }
+
+        if (!advanced)
+        {
+            std::copy(m_saved.begin(), m_saved.end(), m_state.begin());
+            m_lastHiddenStateIdxUsed = lastHiddenStateIdxUsed;
+            return false;
+        }
+
+        m_blockExhausted = false;
+        return true;
+    }
+
+    // The number of distinct permutations of n from all the values, which is size! / (size - n)! when they are
+    // unique. Throws if it does not fit in 64 bits, in which case the ranks are not meaningful either, though the
+    // view can still be advanced.
+    uint64_t Count() const
+    {
+        return Arrangements(m_multiplicities, m_n);
+    }
+
+    // The rank of the current permutation, which is tracked as the view advances. After SkipPrefix on a view
+    // without a rank range it is instead worked out from the state the next time it is asked for, which throws
+    // if the rank does not fit in 64 bits.
+    uint64_t Rank()
+    {
+        if (m_rankStale)
+        {
+            m_rank = RankOfState();
+            m_rankStale = false;
+        }
+
+        return m_rank;
+    }
+
+    // Splits the ranks of this view into at most p_parts contiguous ranges of nearly equal size, in order. Each
+    // one can be given to a separate view to search it on its own thread, but since views permute their data in
+    // place every one of them needs its own copy of the data.
+    std::vector<RankRange> Partition(std::size_t p_parts) const
+    {
+        if (p_parts == 0)
+        {
+            throw std::invalid_argument("There must be at least one part.");
+        }
+
+        const auto begin = m_range.m_begin;
+        const auto end = m_range.m_end == std::numeric_limits<uint64_t>::max() ? Count() : m_range.m_end;
+        const auto total = end - begin;
+        const auto parts = std::min<uint64_t>(p_parts, total);
+
+        // The first total % parts ranges take one extra rank.
+        std::vector<RankRange> ranges;
+        ranges.reserve(parts);
+        auto next = begin;
+        for (uint64_t i = 0; i < parts; ++i)
+        {
+            const auto size = total / parts + (i < total % parts ? 1 : 0);
+            ranges.push_back(RankRange{ next, next + size });
+            next += size;
+        }
+
+        return ranges;
+    }
+
+    // Provides the current view.
+    std::span<const T> Current()
+    {
+        return m_state.subspan(0, m_n);
+    }
+
+    // Given any current state, provides the elements not in the current permutation.
+    std::span<const T> Hidden()
+    {
+        return m_state.subspan(m_n);
+    }
+
+    // Writes up to p_count permutations into a block, starting with the current one and advancing past each one
+    // written, so consecutive calls continue where the last one stopped. Returns the number written, which is
+    // less than requested only when the block is full or the permutations run out, and 0 once they have.
+    std::size_t NextBlock(PermuteBlock<T>& p_block, std::size_t p_count)
+    {
+        if (p_block.Positions() != m_state.size())
+        {
+            throw std::invalid_argument("The block must have a position for every value.");
+        }
+
+        const auto count = std::min(p_count, p_block.Capacity());
+        std::size_t written = 0;
+        while (written < count && !m_blockExhausted)
+        {
+            auto* column = p_block.m_storage.data() + written;
+            for (std::size_t position = 0; position < m_state.size(); ++position)
+            {
+                column[position * p_block.Capacity()] = m_state[position];
+            }
+            ++written;
+
+            if (!Advance())
+            {
+                m_blockExhausted = true;
+            }
+        }
+
+        p_block.m_size = written;
+        return written;
+    }
+
+private:
+    bool Less(const T& p_left, const T& p_right)
+    {
+        return (*static_cast<Compare*>(this))(p_left, p_right) < 0;
+    }
+
+    template <typename Iterator>
+    void SortRange(Iterator p_begin, Iterator p_end)
+    {
+        std::sort(
+            p_begin,
+            p_end,
+            [this](const T& p_left, const T& p_right) { return Less(p_left, p_right); });
+    }
+
+    // Move the values back to the sorted state, which has rank 0.
+    void Sort()
+    {
+        SortRange(m_state.begin(), m_state.end());
+    }
+
+    // The number of permutations of p_taken values out of p_available, p_available! / (p_available - p_taken)!.
+    static uint64_t PartialCount(uint64_t p_available, uint64_t p_taken)
+    {
+        uint64_t count = 1;
+        for (auto factor = p_available - p_taken + 1; factor <= p_available; ++factor)
+        {
+            if (count > std::numeric_limits<uint64_t>::max() / factor)
+            {
+                throw std::overflow_error("The number of permutations does not fit in 64 bits.");
+            }
+            count *= factor;
+        }
+
+        return count;
+    }
+
+    static uint64_t CheckedAdd(uint64_t p_a, uint64_t p_b)
+    {
+        if (p_a > std::numeric_limits<uint64_t>::max() - p_b)
+        {
+            throw std::overflow_error("The number of permutations does not fit in 64 bits.");
+        }
+        return p_a + p_b;
+    }
+
+    static uint64_t CheckedMultiply(uint64_t p_a, uint64_t p_b)
+    {
+        if (p_b != 0 && p_a > std::numeric_limits<uint64_t>::max() / p_b)
+        {
+            throw std::overflow_error("The number of permutations does not fit in 64 bits.");
+        }
+        return p_a * p_b;
+    }
+
+    // The number of distinct sequences of p_taken values drawn from a multiset, given as the multiplicity of each
+    // distinct value. Without duplicates this is PartialCount. Otherwise it is a dynamic program over the values,
+    // where ways[j] counts the sequences of length j using the values so far, and adding t copies of the next
+    // value to a sequence of length j - t can place them in C(j, t) ways.
+    uint64_t Arrangements(std::span<const uint64_t> p_multiplicities, uint64_t p_taken) const
+    {
+        std::vector<uint64_t> ways;
+        return Arrangements(p_multiplicities, p_taken, ways);
+    }
+
+    // Arrangements with the storage for the dynamic program provided, so that it can be reused.
+    uint64_t Arrangements(
+        std::span<const uint64_t> p_multiplicities,
+        uint64_t p_taken,
+        std::vector<uint64_t>& p_ways) const
+    {
+        uint64_t available = 0;
+        for (auto multiplicity : p_multiplicities)
+        {
+            available += multiplicity;
+        }
+        if (p_taken > available)
+        {
+            return 0;
+        }
+        if (!m_hasDuplicates)
+        {
+            return PartialCount(available, p_taken);
+        }
+
+        auto& ways = p_ways;
+        ways.assign(p_taken + 1, 0);
+        ways[0] = 1;
+        for (auto multiplicity : p_multiplicities)
+        {
+            // Going down in length means ways[j - t] has not yet been updated for this value.
+            for (auto length = p_taken; length > 0; --length)
+            {
+                uint64_t binomial = 1;
+                for (uint64_t copies = 1; copies <= std::min(multiplicity, length); ++copies)
+                {
+                    binomial = CheckedMultiply(binomial, length - copies + 1) / copies;
+                    ways[length] = CheckedAdd(ways[length], CheckedMultiply(ways[length - copies], binomial));
+                }
+            }
+        }
+
+        return ways[p_taken];
+    }
+
+    // The position of a value in m_values.
+    std::size_t ValueIndex(const T& p_value)
+    {
+        return static_cast<std::size_t>(std::lower_bound(
+                   m_values.begin(),
+                   m_values.end(),
+                   p_value,
+                   [this](const T& p_left, const T& p_right) { return Less(p_left, p_right); }) -
+               m_values.begin());
+    }
+
+    // Moves the state to the next permutation, regardless of the rank. Returns false, leaving the state unchanged,
+    // after the last permutation.
+    bool AdvanceState()
+    {
+        // A single value only has one permutation.
+        if (m_state.size() < 2)
+        {
+            return false;
+        }
+
         // The Advance algorithm works assuming there is some non-empty hidden state in the permutation
         // past some index which is controlled by m_n. Permutations of size n - 1, over a set n element is
         // still n! permutations and the hidden state completes the full permutation.
@@ -73,93 +503,175 @@ public:
         auto lastVisibleStateIdx = hiddenStateIdx - 1;
         int64_t swapIdx = -1;
 
-        if (m_lastHiddenStateIdxUsed < 0)
+        // The hidden state is always sorted, so the next permutation just replaces the last visible value with
+        // the next larger hidden value if there is one. The values up to m_lastHiddenStateIdxUsed have already
+        // been used, and values equal to the last visible value are skipped so that duplicates are not repeated.
+        auto candidateIdx = m_lastHiddenStateIdxUsed < 0 ? hiddenStateIdx : m_lastHiddenStateIdxUsed + 1;
+        for (; candidateIdx < std::ssize(m_state); ++candidateIdx)
         {
-            for (auto i = hiddenStateIdx; i < std::ssize(m_state); ++i)
+            if (Less(m_state[lastVisibleStateIdx], m_state[candidateIdx]))
             {
-                if (m_state[lastVisibleStateIdx] < m_state[i])
-                {
-                    swapIdx = i;
-                    m_lastHiddenStateIdxUsed = i;
-                    break;
-                }
+                swapIdx = candidateIdx;
+                break;
             }
         }
-        else if (m_lastHiddenStateIdxUsed < (std::ssize(m_state) - 1))
+
+        if (swapIdx >= 0)
+        {
+            std::swap(m_state[lastVisibleStateIdx], m_state[swapIdx]);
+            m_lastHiddenStateIdxUsed = swapIdx;
+            return true;
+        }
+
+        m_lastHiddenStateIdxUsed = -1;
+
+        // Every choice for the last visible value has been used. Reversing the sorted hidden state makes the
+        // whole state the largest sequence that starts with the visible values, so the next permutation of the
+        // whole state changes the visible values as little as possible and leaves the values after the changed
+        // position sorted, including the hidden state. This is std::next_permutation, which also handles
+        // duplicates, but written out so that the view is left unchanged after the last permutation.
+        std::reverse(m_state.begin() + hiddenStateIdx, m_state.end());
+
+        auto pivotIdx = std::ssize(m_state) - 1;
+        while (pivotIdx > 0 && !Less(m_state[pivotIdx - 1], m_state[pivotIdx]))
         {
-            swapIdx = m_lastHiddenStateIdxUsed + 1;
-            ++m_lastHiddenStateIdxUsed;
+            --pivotIdx;
         }
-        else
+
+        if (pivotIdx == 0)
         {
-            m_lastHiddenStateIdxUsed = -1;
+            // All the values in the state were in descending order which means the last permutation was reached.
+            std::reverse(m_state.begin() + hiddenStateIdx, m_state.end());
+            return false;
         }
 
-        if (swapIdx >= 0)
+        --pivotIdx;
+        auto successorIdx = std::ssize(m_state) - 1;
+        while (!Less(m_state[pivotIdx], m_state[successorIdx]))
         {
-            std::swap(m_state[lastVisibleStateIdx], m_state[swapIdx]);
-            return true;
+            --successorIdx;
         }
 
-        int64_t backtrackIdx = hiddenStateIdx;
-        while (--backtrackIdx > 0)
+        std::swap(m_state[pivotIdx], m_state[successorIdx]);
+        std::reverse(m_state.begin() + pivotIdx + 1, m_state.end());
+        return true;
+    }
+
+    // The rank of the current state, found one visible position at a time by counting the permutations that
+    // have the same values before it and a smaller value there. Without duplicates that count is the number of
+    // smaller values after the position times a falling factorial, so the rank is built up digit by digit in the
+    // falling factorial number system with O(n^2) comparisons. Nothing is allocated either way.
+    uint64_t RankOfState()
+    {
+        // Taking size - 1 values is the same as taking all of them, and the ranks are the same.
+        const auto taken = std::min<uint64_t>(m_n, m_state.size() - 1);
+        uint64_t rank = 0;
+        if (!m_hasDuplicates)
         {
-            if (m_state[backtrackIdx] > m_state[backtrackIdx - 1])
+            for (uint64_t i = 0; i < taken; ++i)
             {
-                int64_t probeIdx = backtrackIdx;
-                int64_t minimumLargerIdx = probeIdx;
-                while (probeIdx < std::ssize(m_state))
+                uint64_t smaller = 0;
+                for (auto j = i + 1; j < m_state.size(); ++j)
                 {
-                    if (m_state[backtrackIdx - 1] < m_state[probeIdx] && m_state[probeIdx] < m_state[minimumLargerIdx])
-                    {
-                        minimumLargerIdx = probeIdx;
-                    }
-                    ++probeIdx;
+                    smaller += Less(m_state[j], m_state[i]) ? 1 : 0;
                 }
+                rank = CheckedAdd(CheckedMultiply(rank, m_state.size() - i), smaller);
+            }
 
-                std::swap(m_state[backtrackIdx - 1], m_state[minimumLargerIdx]);
-                std::reverse(m_state.begin() + backtrackIdx, m_state.begin() + hiddenStateIdx);
-                std::rotate(m_state.begin() + backtrackIdx, m_state.begin() + hiddenStateIdx, m_state.end());
+            return rank;
+        }
 
-                return true;
+        std::copy(m_multiplicities.begin(), m_multiplicities.end(), m_remaining.begin());
+        for (uint64_t i = 0; i < taken; ++i)
+        {
+            const auto valueIdx = ValueIndex(m_state[i]);
+            for (std::size_t smaller = 0; smaller < valueIdx; ++smaller)
+            {
+                if (m_remaining[smaller] > 0)
+                {
+                    --m_remaining[smaller];
+                    rank = CheckedAdd(rank, Arrangements(m_remaining, taken - 1 - i, m_ways));
+                    ++m_remaining[smaller];
+                }
             }
+            --m_remaining[valueIdx];
         }
 
-        // All the values in the state were in ascending order starting from the last
-        // value which means the last permutation was reached.
-        return false;
+        return rank;
     }
 
-    // Move the permutation back to the initial state.
-    void Reset()
+    // Moves the view from the sorted state to the permutation with the given rank. The rank is decoded one
+    // visible position at a time: each distinct remaining value, in order, is the value at position i for as
+    // many permutations as there are arrangements of the other remaining values in the positions after it, so
+    // those counts are skipped until the rank falls within one. Rotating the chosen value into place keeps the
+    // remaining values sorted, which leaves the hidden state sorted as Advance expects.
+    void Unrank(uint64_t p_rank)
     {
-        std::sort(
-            m_state.begin(),
-            m_state.end(),
-            [this](const T& p_left, const T& p_right) { return (*static_cast<Compare*>(this))(p_left, p_right) < 0; });
-    }
+        m_rank = p_rank;
+        m_rankStale = false;
+        m_lastHiddenStateIdxUsed = -1;
 
-    // Provides the current view.
-    std::span<const T> Current()
-    {
-        return m_state.subspan(0, m_n);
-    }
+        // Taking size - 1 values is the same as taking all of them, and the count is the same.
+        const auto taken = std::min<uint64_t>(m_n, m_state.size() - 1);
+        auto remaining = m_multiplicities;
+        for (uint64_t i = 0; i < taken; ++i)
+        {
+            // The remaining values are sorted, so the distinct ones are visited in order along with their
+            // first positions.
+            auto position = i;
+            for (std::size_t valueIdx = 0; valueIdx < remaining.size(); ++valueIdx)
+            {
+                if (remaining[valueIdx] == 0)
+                {
+                    continue;
+                }
 
-    // Given any current state, provides the elements not in the current permutation.
-    std::span<const T> Hidden()
-    {
-        return m_state.subspan(m_n);
+                --remaining[valueIdx];
+                const auto below = Arrangements(remaining, taken - 1 - i);
+                if (p_rank < below)
+                {
+                    std::rotate(m_state.begin() + i, m_state.begin() + position, m_state.begin() + position + 1);
+                    break;
+                }
+
+                p_rank -= below;
+                position += ++remaining[valueIdx];
+            }
+        }
     }
 
-private:
     // The values that are being permuted over.
     std::span<T> m_state;
 
     // The number of values to include in the visible state.
     uint64_t m_n;
 
+    // The distinct values in sorted order, and how many times each one occurs.
+    std::vector<T> m_values;
+    std::vector<uint64_t> m_multiplicities;
+
+    // Whether any value occurs more than once, otherwise the counts have a closed form.
+    bool m_hasDuplicates = false;
+
     // In the hidden state, keeps track of the last index that was swapped into the
     // visible state to allow for a small optimization on the path where the last
     // value in a permutation is incremented via values from the hidden state.
     int64_t m_lastHiddenStateIdxUsed;
+
+    // The ranks this view visits.
+    RankRange m_range;
+
+    // The rank of the current permutation.
+    uint64_t m_rank;
+
+    // Whether m_rank is out of date since SkipPrefix moved a view without a rank range.
+    bool m_rankStale = false;
+
+    // Scratch space for SkipPrefix and RankOfState, allocated once so that pruning does not allocate.
+    std::vector<T> m_saved;
+    std::vector<uint64_t> m_remaining;
+    std::vector<uint64_t> m_ways;
+
+    // Whether NextBlock has written the last permutation.
+    bool m_blockExhausted = false;
 };
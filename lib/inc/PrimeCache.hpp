@@ -0,0 +1,504 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Sieve.hpp"
+
+namespace euler
+{
+    namespace sieve
+    {
+        /// <summary>
+        /// A persistent cache of a WheelSieve that is stored on disk and memory mapped read only, so that it can be
+        /// shared between runs and between concurrent processes. When a larger bound is requested than the file
+        /// holds, the sieve is recomputed at a larger size and the file is atomically replaced, which leaves any
+        /// existing mappings in other processes valid. Windows does not allow replacing a file that is mapped, so
+        /// there the old file is first renamed aside, and it is deleted once no process has it mapped anymore.
+        ///
+        /// The file format is versioned and consists of a fixed header followed by the wheel words:
+        ///   [0, 8)   The magic bytes "EULPRIME".
+        ///   [8, 12)  The format version.
+        ///   [12, 16) The size of the header in bytes.
+        ///   [16, 24) The exclusive upper bound of the sieve.
+        ///   [24, 32) The number of wheel words that follow.
+        ///   [32, ..) The wheel words, see WheelView for their layout.
+        /// All integers are stored little endian.
+        /// </summary>
+        class PrimeCache
+        {
+            static_assert(std::endian::native == std::endian::little, "The cache file is stored little endian.");
+
+        public:
+            /// <summary>
+            /// The current version of the file format. Files with a different version are regenerated.
+            /// </summary>
+            static constexpr uint32_t c_version = 1;
+
+            /// <summary>
+            /// Open the cache at the given path. The file does not need to exist yet, it is created by the first
+            /// call to Require.
+            /// </summary>
+            /// <param name="p_path">The location of the cache file.</param>
+            explicit PrimeCache(std::filesystem::path p_path)
+                : m_path(std::move(p_path))
+            {
+                Map();
+            }
+
+            ~PrimeCache()
+            {
+                Unmap();
+            }
+
+            // Not copyable since the mapping is uniquely owned.
+            PrimeCache(const PrimeCache&) = delete;
+            PrimeCache& operator=(const PrimeCache&) = delete;
+
+            // Moveable.
+            PrimeCache(PrimeCache&& p_other) noexcept
+                : m_path(std::move(p_other.m_path)),
+                  m_data(std::exchange(p_other.m_data, nullptr)),
+                  m_size(std::exchange(p_other.m_size, 0)),
+                  m_view(std::exchange(p_other.m_view, WheelView())),
+                  m_local(std::move(p_other.m_local))
+#ifdef _WIN32
+                  , m_mapping(std::exchange(p_other.m_mapping, nullptr))
+#endif
+            {
+                if (m_local)
+                {
+                    m_view = m_local->View();
+                }
+            }
+
+            PrimeCache& operator=(PrimeCache&& p_other) noexcept
+            {
+                if (this != &p_other)
+                {
+                    Unmap();
+                    m_path = std::move(p_other.m_path);
+                    m_data = std::exchange(p_other.m_data, nullptr);
+                    m_size = std::exchange(p_other.m_size, 0);
+                    m_view = std::exchange(p_other.m_view, WheelView());
+                    m_local = std::move(p_other.m_local);
+#ifdef _WIN32
+                    m_mapping = std::exchange(p_other.m_mapping, nullptr);
+#endif
+                    if (m_local)
+                    {
+                        m_view = m_local->View();
+                    }
+                }
+                return *this;
+            }
+
+            /// <summary>
+            /// Provides the primes in [0, p_n), and possibly more. If the cache does not cover the bound, it is first
+            /// reloaded in case another process grew it, and otherwise it is grown to at least double its size.
+            /// </summary>
+            /// <remarks>Views returned previously are invalidated if the cache has to be reloaded or grown.</remarks>
+            /// <param name="p_n">The exclusive upper bound that must be covered.</param>
+            /// <returns>A view over the cached sieve.</returns>
+            WheelView Require(uint64_t p_n)
+            {
+                if (m_view.Bound() >= p_n)
+                {
+                    return m_view;
+                }
+
+                Map();
+                if (m_view.Bound() < p_n)
+                {
+                    Grow(std::max(p_n, 2 * m_view.Bound()));
+                }
+
+                return m_view;
+            }
+
+            /// <summary>
+            /// Provides the currently cached sieve without growing it.
+            /// </summary>
+            WheelView View() const
+            {
+                return m_view;
+            }
+
+            /// <summary>
+            /// The cache that ForEachPrimeBelow reads from, or null if none was set, in which case it sieves. The
+            /// driver sets this once at startup, and it is not synchronized, so it should only be used from one
+            /// thread.
+            /// </summary>
+            static PrimeCache* Shared()
+            {
+                return SharedStorage();
+            }
+
+            /// <summary>
+            /// Sets the cache that ForEachPrimeBelow reads from. The cache must outlive its use, or be unset with null.
+            /// </summary>
+            static void SetShared(PrimeCache* p_cache)
+            {
+                SharedStorage() = p_cache;
+            }
+
+        private:
+            static PrimeCache*& SharedStorage()
+            {
+                static PrimeCache* shared{};
+                return shared;
+            }
+
+            /// <summary>
+            /// The size of the file header in bytes.
+            /// </summary>
+            static constexpr std::size_t c_headerSize = 32;
+
+            /// <summary>
+            /// The magic bytes that start the file.
+            /// </summary>
+            static constexpr std::array<char, 8> c_magic{ 'E', 'U', 'L', 'P', 'R', 'I', 'M', 'E' };
+
+            /// <summary>
+            /// The largest bound whose number of wheel words can be computed without overflowing.
+            /// </summary>
+            static constexpr uint64_t c_maxBound = std::numeric_limits<uint64_t>::max() - 239;
+
+            /// <summary>
+            /// Maps the file on disk if it exists and is valid, replacing any current mapping. An invalid or missing
+            /// file leaves the cache empty.
+            /// </summary>
+            void Map()
+            {
+                Unmap();
+                m_view = WheelView();
+
+#ifdef _WIN32
+                auto file = CreateFileW(
+                    m_path.c_str(),
+                    GENERIC_READ,
+                    FILE_SHARE_READ | FILE_SHARE_DELETE,
+                    nullptr,
+                    OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL,
+                    nullptr);
+                if (file == INVALID_HANDLE_VALUE)
+                {
+                    return;
+                }
+
+                LARGE_INTEGER size{};
+                if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(c_headerSize))
+                {
+                    CloseHandle(file);
+                    return;
+                }
+
+                // The file handle is not needed once the mapping exists, the mapping keeps the file open.
+                m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(file);
+                if (m_mapping == nullptr)
+                {
+                    return;
+                }
+
+                m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                if (m_data == nullptr)
+                {
+                    Unmap();
+                    return;
+                }
+                m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+                auto fd = open(m_path.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    return;
+                }
+
+                struct stat info{};
+                if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(c_headerSize))
+                {
+                    close(fd);
+                    return;
+                }
+
+                // The descriptor is not needed once the mapping exists, the mapping keeps the file open.
+                auto data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+                close(fd);
+                if (data == MAP_FAILED)
+                {
+                    return;
+                }
+
+                m_data = static_cast<const std::byte*>(data);
+                m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+                std::array<char, 8> magic{};
+                uint32_t version{};
+                uint32_t headerSize{};
+                uint64_t bound{};
+                uint64_t wordCount{};
+                std::memcpy(magic.data(), m_data, sizeof(magic));
+                std::memcpy(&version, m_data + 8, sizeof(version));
+                std::memcpy(&headerSize, m_data + 12, sizeof(headerSize));
+                std::memcpy(&bound, m_data + 16, sizeof(bound));
+                std::memcpy(&wordCount, m_data + 24, sizeof(wordCount));
+
+                const bool valid =
+                    magic == c_magic &&
+                    version == c_version &&
+                    headerSize == c_headerSize &&
+                    bound <= c_maxBound &&
+                    wordCount == (bound + 239) / 240 &&
+                    wordCount <= (m_size - c_headerSize) / sizeof(uint64_t);
+                if (!valid)
+                {
+                    Unmap();
+                    return;
+                }
+
+                m_view = WheelView(
+                    std::span<const uint64_t>(
+                        reinterpret_cast<const uint64_t*>(m_data + c_headerSize),
+                        static_cast<std::size_t>(wordCount)),
+                    bound);
+            }
+
+            /// <summary>
+            /// Releases the current mapping, if there is one.
+            /// </summary>
+            void Unmap()
+            {
+#ifdef _WIN32
+                if (m_data != nullptr)
+                {
+                    UnmapViewOfFile(m_data);
+                }
+                if (m_mapping != nullptr)
+                {
+                    CloseHandle(m_mapping);
+                    m_mapping = nullptr;
+                }
+#else
+                if (m_data != nullptr)
+                {
+                    munmap(const_cast<std::byte*>(m_data), m_size);
+                }
+#endif
+                m_data = nullptr;
+                m_size = 0;
+            }
+
+            /// <summary>
+            /// Replaces the cache file with p_source. The current mapping must be released first since Windows
+            /// refuses to replace a file that this process has mapped.
+            /// </summary>
+            void Replace(const std::filesystem::path& p_source, std::error_code& p_error)
+            {
+                std::filesystem::rename(p_source, m_path, p_error);
+#ifdef _WIN32
+                if (!p_error)
+                {
+                    return;
+                }
+
+                // Another process still has the file mapped. A mapped file can be renamed, just not replaced or
+                // deleted, so move it aside under a unique name and put the new file in its place.
+                std::random_device random;
+                auto retired = m_path;
+                retired += "." + std::to_string(random()) + ".old";
+                std::filesystem::rename(m_path, retired, p_error);
+                if (p_error)
+                {
+                    return;
+                }
+
+                std::error_code ignored;
+                std::filesystem::rename(p_source, m_path, p_error);
+                if (p_error)
+                {
+                    std::filesystem::rename(retired, m_path, ignored);
+                }
+#endif
+            }
+
+            /// <summary>
+            /// Deletes files that earlier calls to Replace moved aside, once no process has them mapped anymore.
+            /// Files that are still mapped fail to delete and are left for a later call.
+            /// </summary>
+            void RemoveRetired() const
+            {
+#ifdef _WIN32
+                std::error_code error;
+                const auto directory = m_path.has_parent_path() ? m_path.parent_path() : std::filesystem::path(".");
+                const auto prefix = m_path.filename().wstring() + L".";
+                for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+                {
+                    const auto name = entry.path().filename().wstring();
+                    if (name.starts_with(prefix) && name.ends_with(L".old"))
+                    {
+                        std::error_code ignored;
+                        std::filesystem::remove(entry.path(), ignored);
+                    }
+                }
+#endif
+            }
+
+            /// <summary>
+            /// Sieves the range [0, p_n) and replaces the file on disk with the result. The file is written under a
+            /// unique temporary name and renamed over the cache so that concurrent readers never see a partial file.
+            /// If the file cannot be replaced, for example if the directory is read only, the sieve is kept in memory
+            /// for the lifetime of this instance instead.
+            /// </summary>
+            void Grow(uint64_t p_n)
+            {
+                if (p_n > c_maxBound)
+                {
+                    throw std::out_of_range("The bound is too large for the prime cache.");
+                }
+
+                // Round up to a whole number of words since the last word is stored in full anyway.
+                const auto bound = (p_n + 239) / 240 * 240;
+                WheelSieve sieve(bound);
+                const auto words = sieve.View().Words();
+
+                std::random_device random;
+                auto temp = m_path;
+                temp += "." + std::to_string(random()) + ".tmp";
+
+                std::error_code error;
+                {
+                    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+                    const uint64_t wordCount = words.size();
+                    out.write(c_magic.data(), c_magic.size());
+                    out.write(reinterpret_cast<const char*>(&c_version), sizeof(c_version));
+                    const auto headerSize = static_cast<uint32_t>(c_headerSize);
+                    out.write(reinterpret_cast<const char*>(&headerSize), sizeof(headerSize));
+                    out.write(reinterpret_cast<const char*>(&bound), sizeof(bound));
+                    out.write(reinterpret_cast<const char*>(&wordCount), sizeof(wordCount));
+                    out.write(reinterpret_cast<const char*>(words.data()), words.size_bytes());
+                    if (!out.flush())
+                    {
+                        error = std::make_error_code(std::errc::io_error);
+                    }
+                }
+
+                if (!error)
+                {
+                    Unmap();
+                    Replace(temp, error);
+                    RemoveRetired();
+                }
+
+                if (!error)
+                {
+                    Map();
+                }
+
+                if (error || m_view.Bound() < p_n)
+                {
+                    std::filesystem::remove(temp, error);
+                    Unmap();
+                    m_local.emplace(std::move(sieve));
+                    m_view = m_local->View();
+                }
+            }
+
+            /// <summary>
+            /// The location of the cache file.
+            /// </summary>
+            std::filesystem::path m_path;
+
+            /// <summary>
+            /// The start of the mapped file, or null if nothing is mapped.
+            /// </summary>
+            const std::byte* m_data{};
+
+            /// <summary>
+            /// The size of the mapped file in bytes.
+            /// </summary>
+            std::size_t m_size{};
+
+            /// <summary>
+            /// The view over the mapped file, or over m_local if the file could not be written.
+            /// </summary>
+            WheelView m_view;
+
+            /// <summary>
+            /// A sieve kept in memory when the file on disk could not be replaced.
+            /// </summary>
+            std::optional<WheelSieve> m_local;
+
+#ifdef _WIN32
+            /// <summary>
+            /// The file mapping object backing m_data.
+            /// </summary>
+            HANDLE m_mapping{};
+#endif
+        };
+
+        /// <summary>
+        /// Invokes the callable with the primes in [0, p_n) in ascending order until it returns false. The primes are
+        /// read from the shared PrimeCache if there is one, growing it if it does not cover the bound, so repeated
+        /// runs only sieve once. Otherwise they are sieved lazily with Primes.
+        /// </summary>
+        /// <param name="p_n">The exclusive upper bound of the primes.</param>
+        /// <param name="p_fn">The callable, which returns whether to continue.</param>
+        template <typename T, typename Fn>
+        void ForEachPrimeBelow(T p_n, Fn&& p_fn)
+        {
+            if (p_n <= 2)
+            {
+                return;
+            }
+
+            if (auto* cache = PrimeCache::Shared(); cache != nullptr)
+            {
+                // The cache may cover more than the bound, so stop at the bound as well.
+                const auto bound = static_cast<uint64_t>(p_n);
+                cache->Require(bound).ForEachPrime(
+                    [&](uint64_t p_prime) { return p_prime < bound && p_fn(static_cast<T>(p_prime)); });
+                return;
+            }
+
+            for (auto prime : Primes<T>(p_n))
+            {
+                if (!p_fn(prime))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
@@ -1,12 +1,172 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EULER_SIEVE_SSE2
+#endif
+
 namespace euler
 {
     namespace sieve
     {
+        namespace detail
+        {
+            /// <summary>
+            /// Computes floor(sqrt(p_n)) for a non-negative integer. The floating point estimate is corrected since
+            /// doubles cannot represent every integer past 2^53.
+            /// </summary>
+            template <typename T>
+            T FloorSqrt(T p_n)
+            {
+                auto root = static_cast<T>(std::sqrt(static_cast<double>(p_n)));
+                // Compare with division rather than squaring so that the checks cannot overflow T.
+                while (root > 0 && root > p_n / root)
+                {
+                    --root;
+                }
+                while (root + 1 <= p_n / (root + 1))
+                {
+                    ++root;
+                }
+                return root;
+            }
+
+            /// <summary>
+            /// Runs the Lucy_Hedgehog algorithm to compute the sum of g(p) over the primes p in [2, p_x], for some
+            /// completely multiplicative g. The partial sums S(v) over [2, v] are tracked only for the O(sqrt(x))
+            /// distinct values of floor(x / i). They start as the sum over all integers, and sieving out each prime p
+            /// removes g(p) times the sum over the values with smallest prime factor p:
+            ///   S(v) -= g(p) * (S(v / p) - S(p - 1))
+            /// This runs in O(x^(3/4)) time and O(sqrt(x)) memory.
+            /// </summary>
+            /// <param name="p_x">The inclusive upper bound.</param>
+            /// <param name="p_initial">Provides the sum of g over all integers in [2, v].</param>
+            /// <param name="p_weight">Provides g(p) for a prime p.</param>
+            template <typename R, typename T, typename Initial, typename Weight>
+            R LucyHedgehog(T p_x, Initial&& p_initial, Weight&& p_weight)
+            {
+                if (p_x < 2)
+                {
+                    return R{};
+                }
+
+                const auto root = FloorSqrt<T>(p_x);
+                const auto size = static_cast<std::size_t>(root) + 1;
+
+                // small[v] = S(v) for v <= root, large[i] = S(x / i) for i <= root.
+                std::vector<R> small(size);
+                std::vector<R> large(size);
+                for (T v = 1; v <= root; ++v)
+                {
+                    small[static_cast<std::size_t>(v)] = p_initial(v);
+                    large[static_cast<std::size_t>(v)] = p_initial(p_x / v);
+                }
+
+                for (T p = 2; p <= root; ++p)
+                {
+                    // S(p) only changes from S(p - 1) when p has not been sieved out, i.e. when p is prime.
+                    const auto previous = small[static_cast<std::size_t>(p - 1)];
+                    if (small[static_cast<std::size_t>(p)] == previous)
+                    {
+                        continue;
+                    }
+
+                    const R weight = p_weight(p);
+                    const auto square = p * p;
+                    const auto largeEnd = std::min<T>(root, p_x / square);
+                    for (T i = 1; i <= largeEnd; ++i)
+                    {
+                        const auto d = i * p;
+                        const auto& quotient =
+                            d <= root ? large[static_cast<std::size_t>(d)] : small[static_cast<std::size_t>(p_x / d)];
+                        large[static_cast<std::size_t>(i)] -= weight * (quotient - previous);
+                    }
+
+                    for (T v = root; v >= square; --v)
+                    {
+                        small[static_cast<std::size_t>(v)] -= weight * (small[static_cast<std::size_t>(v / p)] - previous);
+                    }
+                }
+
+                return large[1];
+            }
+        }
+
+        /// <summary>
+        /// Counts the primes less than or equal to p_x, i.e. pi(x), in O(x^(3/4)) time without sieving the range.
+        /// </summary>
+        /// <typeparam name="T">The integral type of the bound and the count.</typeparam>
+        /// <param name="p_x">The inclusive upper bound.</param>
+        /// <returns>The number of primes in [2, p_x].</returns>
+        template <typename T>
+        T PrimeCount(T p_x)
+        {
+            return detail::LucyHedgehog<T>(
+                p_x,
+                [](T p_v) { return p_v - 1; },
+                [](T) { return T{ 1 }; });
+        }
+
+        /// <summary>
+        /// Sums the primes less than or equal to p_x in O(x^(3/4)) time without sieving the range.
+        /// </summary>
+        /// <remarks>The sum grows like x^2 / (2 ln x), and intermediate values like x^2 / 2, so R must be wide
+        /// enough for that. A 64 bit R handles x up to around 4 * 10^9.</remarks>
+        /// <typeparam name="R">The type the sum is computed in.</typeparam>
+        /// <typeparam name="T">The integral type of the bound.</typeparam>
+        /// <param name="p_x">The inclusive upper bound.</param>
+        /// <returns>The sum of the primes in [2, p_x].</returns>
+        template <typename R = int64_t, typename T>
+        R PrimeSum(T p_x)
+        {
+            return detail::LucyHedgehog<R>(
+                p_x,
+                [](T p_v)
+                {
+                    // Halve whichever factor is even so that v(v + 1) / 2 does not overflow before the division.
+                    return p_v % 2 == 0
+                        ? R(p_v / 2) * R(p_v + 1) - R{ 1 }
+                        : R(p_v) * R((p_v + 1) / 2) - R{ 1 };
+                },
+                [](T p_p) { return R(p_p); });
+        }
+
+        /// <summary>
+        /// Reserves space in a container for the primes in [0, p_n) if the container supports it. The count is
+        /// computed exactly with PrimeCount, which is sublinear and so cheap relative to sieving the range.
+        /// </summary>
+        template <typename Container, typename T>
+        void ReserveForPrimes(Container& p_container, T p_n)
+        {
+            if constexpr (requires { p_container.reserve(p_container.size()); })
+            {
+                if (p_n > 2)
+                {
+                    p_container.reserve(p_container.size() + static_cast<std::size_t>(PrimeCount<T>(p_n - 1)));
+                }
+            }
+        }
+
         /// <summary>
         /// Finds the prime numbers within the range [0, p_n).
         /// </summary>
@@ -25,10 +185,10 @@ namespace euler
                 return;
             }
 
-            // TODO: Preallocation of container to maximum amount of primes in a range...
+            ReserveForPrimes(p_container, p_n);
 
-            // TODO: Consider changing to boost::dynamic_bitset
-            // TODO: Consider most space efficient implementation.
+            // WheelSieve provides a more space efficient representation when only the primality of values is
+            // needed rather than a list of the primes.
             std::vector<bool, Allocator> marked(p_n, false, p_alloc);
 
             // TODO: Do optimization to remove all even numbers from consideration
@@ -65,5 +225,1235 @@ namespace euler
                 }
             }
         }
+
+        /// <summary>
+        /// The default number of bytes in a segment of SegmentedEratosthenes. Each byte represents one odd number so
+        /// this covers twice as many integers, and is small enough to stay resident in a typical L1 data cache.
+        /// </summary>
+        constexpr std::size_t c_defaultSegmentSize = 32 * 1024;
+
+        namespace detail
+        {
+            /// <summary>
+            /// Finds the odd primes that are needed to sieve the range [0, p_n), i.e. the odd primes no larger than
+            /// sqrt(p_n - 1).
+            /// </summary>
+            template <typename T>
+            std::vector<T> OddBasePrimes(T p_n)
+            {
+                std::vector<T> basePrimes;
+                if (p_n > 2)
+                {
+                    Eratosthenes(basePrimes, FloorSqrt<T>(p_n - 1) + 1);
+                }
+                if (!basePrimes.empty())
+                {
+                    basePrimes.erase(basePrimes.begin());
+                }
+                return basePrimes;
+            }
+
+            /// <summary>
+            /// A precomputed, periodic marking of the odd multiples of a group of small primes, for pre-sieving
+            /// windows. Byte j marks the odd number 2j + 1. The pattern is padded past its period with its own start so
+            /// that a full vector can be loaded from any offset within the period.
+            /// </summary>
+            struct PreSievePattern
+            {
+                /// <summary>
+                /// The number of bytes that the marking repeats after, i.e. the product of the primes.
+                /// </summary>
+                std::size_t m_period;
+
+                /// <summary>
+                /// The pattern followed by the padding.
+                /// </summary>
+                std::vector<uint8_t> m_bytes;
+            };
+
+            /// <summary>
+            /// The number of bytes of padding after the period of a pre-sieve pattern. At least the widest vector.
+            /// </summary>
+            constexpr std::size_t c_preSievePadding = 32;
+
+            /// <summary>
+            /// The small primes that are handled by the pre-sieve rather than by marking windows one store at a time.
+            /// </summary>
+            constexpr std::array<uint8_t, 7> c_preSievePrimes{ 3, 5, 7, 11, 13, 17, 19 };
+
+            inline PreSievePattern CreatePreSievePattern(std::initializer_list<std::size_t> p_primes)
+            {
+                PreSievePattern pattern{ 1, {} };
+                for (auto prime : p_primes)
+                {
+                    pattern.m_period *= prime;
+                }
+
+                pattern.m_bytes.resize(pattern.m_period + c_preSievePadding);
+                for (std::size_t j = 0; j < pattern.m_bytes.size(); ++j)
+                {
+                    for (auto prime : p_primes)
+                    {
+                        if ((2 * j + 1) % prime == 0)
+                        {
+                            pattern.m_bytes[j] = 1;
+                        }
+                    }
+                }
+                return pattern;
+            }
+
+            /// <summary>
+            /// Initializes a window with the marks for the odd multiples of 3 through 19, including the primes
+            /// themselves. The product of all seven primes is too large a period to store, so they are split in two
+            /// patterns, 3 * 5 * 7 * 11 * 13 = 15015 bytes and 17 * 19 = 323 bytes, which are combined with a vector
+            /// OR at the matching offsets. Every byte covers one odd number as in SieveOddSegment.
+            /// </summary>
+            /// <param name="p_marks">The window to initialize.</param>
+            /// <param name="p_firstIdx">The index of the first byte of the window on the whole number line, i.e. the
+            /// byte for the odd number 2 * p_firstIdx + 1.</param>
+            inline void PreSieve(std::span<uint8_t> p_marks, uint64_t p_firstIdx)
+            {
+                static const auto lowPattern = CreatePreSievePattern({ 3, 5, 7, 11, 13 });
+                static const auto highPattern = CreatePreSievePattern({ 17, 19 });
+
+                const auto* low = lowPattern.m_bytes.data();
+                const auto* high = highPattern.m_bytes.data();
+                auto lowOffset = static_cast<std::size_t>(p_firstIdx % lowPattern.m_period);
+                auto highOffset = static_cast<std::size_t>(p_firstIdx % highPattern.m_period);
+                auto advance = [&](std::size_t p_step)
+                {
+                    lowOffset += p_step;
+                    if (lowOffset >= lowPattern.m_period)
+                    {
+                        lowOffset -= lowPattern.m_period;
+                    }
+                    highOffset += p_step;
+                    if (highOffset >= highPattern.m_period)
+                    {
+                        highOffset -= highPattern.m_period;
+                    }
+                };
+
+                auto* out = p_marks.data();
+                std::size_t i = 0;
+#if defined(__AVX2__)
+                for (; i + 32 <= p_marks.size(); i += 32)
+                {
+                    const auto lowBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(low + lowOffset));
+                    const auto highBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(high + highOffset));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_or_si256(lowBytes, highBytes));
+                    advance(32);
+                }
+#elif defined(EULER_SIEVE_SSE2)
+                for (; i + 16 <= p_marks.size(); i += 16)
+                {
+                    const auto lowBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low + lowOffset));
+                    const auto highBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high + highOffset));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(lowBytes, highBytes));
+                    advance(16);
+                }
+#endif
+                for (; i < p_marks.size(); ++i)
+                {
+                    out[i] = low[lowOffset] | high[highOffset];
+                    advance(1);
+                }
+
+                // The pre-sieve primes mark themselves, so clear them again if they are in the window.
+                for (uint64_t prime : c_preSievePrimes)
+                {
+                    if (prime / 2 >= p_firstIdx && prime / 2 - p_firstIdx < p_marks.size())
+                    {
+                        p_marks[static_cast<std::size_t>(prime / 2 - p_firstIdx)] = 0;
+                    }
+                }
+            }
+
+            /// <summary>
+            /// Marks the odd composites in a window of the number line. The byte at index i represents the odd number
+            /// p_low + 2i + 1, and is set to 1 if that number is a multiple of one of the base primes and 0 otherwise.
+            /// </summary>
+            /// <param name="p_marks">The window to mark. Any previous contents are overwritten.</param>
+            /// <param name="p_low">The even number the window starts at.</param>
+            /// <param name="p_basePrimes">The odd primes up to the square root of the end of the window.</param>
+            template <typename T>
+            void SieveOddSegment(std::span<uint8_t> p_marks, T p_low, std::span<const T> p_basePrimes)
+            {
+                PreSieve(p_marks, static_cast<uint64_t>(p_low / 2));
+
+                const auto high = p_low + 2 * static_cast<T>(p_marks.size());
+                for (auto prime : p_basePrimes)
+                {
+                    if (prime <= c_preSievePrimes.back())
+                    {
+                        continue;
+                    }
+
+                    // Start at the square of the prime, since any smaller composite has a smaller prime factor, or
+                    // at the first odd multiple inside the window if the square comes before it.
+                    auto first = prime * prime;
+                    if (first >= high)
+                    {
+                        break;
+                    }
+                    if (first < p_low)
+                    {
+                        first = (p_low + prime - 1) / prime * prime;
+                        if (first % 2 == 0)
+                        {
+                            first += prime;
+                        }
+                    }
+
+                    // Consecutive odd multiples are 2 * prime apart which is a stride of prime in the window.
+                    for (auto idx = static_cast<std::size_t>((first - p_low) / 2); idx < p_marks.size(); idx += prime)
+                    {
+                        p_marks[idx] = 1;
+                    }
+                }
+            }
+
+            /// <summary>
+            /// Invokes the callable with every odd prime in a window marked by SieveOddSegment that is less than
+            /// p_high, in ascending order.
+            /// </summary>
+            template <typename T, typename Fn>
+            void ForEachOddPrime(std::span<const uint8_t> p_marks, T p_low, T p_high, Fn&& p_fn)
+            {
+                for (std::size_t idx = 0; idx < p_marks.size(); ++idx)
+                {
+                    const auto value = p_low + 2 * static_cast<T>(idx) + 1;
+                    if (value >= p_high)
+                    {
+                        break;
+                    }
+                    if (!p_marks[idx] && value != 1)
+                    {
+                        p_fn(value);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Finds the prime numbers within the range [0, p_n) like Eratosthenes, but walks the range in fixed size
+        /// windows so that the memory used only grows with sqrt(p_n) rather than p_n. Only odd numbers are stored in
+        /// the windows, and each window is sieved with the odd primes up to sqrt(p_n) before moving on to the next,
+        /// which keeps all the marking within the cache.
+        /// </summary>
+        /// <typeparam name="Container">The type of container the primes are appended to.</typeparam>
+        /// <typeparam name="T">The integral type used for the range.</typeparam>
+        /// <param name="p_container">The container the primes are appended to in ascending order.</param>
+        /// <param name="p_n">The exclusive upper bound of the range.</param>
+        /// <param name="p_segmentSize">The number of bytes in a window. Each byte covers one odd number.</param>
+        template <typename Container, typename T>
+        void SegmentedEratosthenes(Container& p_container, T p_n, std::size_t p_segmentSize = c_defaultSegmentSize)
+        {
+            if (p_n < 3)
+            {
+                return;
+            }
+
+            ReserveForPrimes(p_container, p_n);
+            p_container.push_back(2);
+
+            const auto basePrimes = detail::OddBasePrimes(p_n);
+            std::vector<uint8_t> marks(std::max<std::size_t>(p_segmentSize, 1));
+            const auto span = 2 * static_cast<T>(marks.size());
+
+            for (T low = 0; low < p_n; low += span)
+            {
+                auto window = std::span<uint8_t>(marks);
+                if (p_n - low < span)
+                {
+                    window = window.subspan(0, static_cast<std::size_t>((p_n - low + 1) / 2));
+                }
+
+                detail::SieveOddSegment<T>(window, low, basePrimes);
+                detail::ForEachOddPrime<T>(window, low, p_n, [&](T p_prime) { p_container.push_back(p_prime); });
+            }
+        }
+
+        /// <summary>
+        /// Finds the prime numbers within the range [0, p_n) using multiple threads. The windows of
+        /// SegmentedEratosthenes are split into contiguous runs, one per thread, and each thread sieves its run with
+        /// the shared base primes into a local buffer. The buffers are then appended in order so the output is
+        /// exactly the same as the serial sieve.
+        /// </summary>
+        /// <typeparam name="Container">The type of container the primes are appended to.</typeparam>
+        /// <typeparam name="T">The integral type used for the range.</typeparam>
+        /// <param name="p_container">The container the primes are appended to in ascending order.</param>
+        /// <param name="p_n">The exclusive upper bound of the range.</param>
+        /// <param name="p_threadCount">The number of worker threads to use. 0 is treated as 1.</param>
+        /// <param name="p_segmentSize">The number of bytes in a window. Each byte covers one odd number.</param>
+        template <typename Container, typename T>
+        void ParallelEratosthenes(
+            Container& p_container,
+            T p_n,
+            unsigned p_threadCount = std::thread::hardware_concurrency(),
+            std::size_t p_segmentSize = c_defaultSegmentSize)
+        {
+            if (p_n < 3)
+            {
+                return;
+            }
+
+            const auto basePrimes = detail::OddBasePrimes(p_n);
+            const auto segmentSize = std::max<std::size_t>(p_segmentSize, 1);
+            const auto span = 2 * static_cast<T>(segmentSize);
+            const auto segmentCount = static_cast<uint64_t>((p_n + span - 1) / span);
+            const auto threadCount = static_cast<uint64_t>(std::clamp<uint64_t>(p_threadCount, 1, segmentCount));
+
+            std::vector<std::vector<T>> results(threadCount);
+            std::vector<std::exception_ptr> errors(threadCount);
+            auto work = [&](uint64_t p_worker)
+            {
+                try
+                {
+                    std::vector<uint8_t> marks(segmentSize);
+                    const auto firstSegment = p_worker * segmentCount / threadCount;
+                    const auto lastSegment = (p_worker + 1) * segmentCount / threadCount;
+                    for (auto segment = firstSegment; segment < lastSegment; ++segment)
+                    {
+                        const auto low = static_cast<T>(segment) * span;
+                        auto window = std::span<uint8_t>(marks);
+                        if (p_n - low < span)
+                        {
+                            window = window.subspan(0, static_cast<std::size_t>((p_n - low + 1) / 2));
+                        }
+
+                        detail::SieveOddSegment<T>(window, low, basePrimes);
+                        detail::ForEachOddPrime<T>(
+                            window, low, p_n, [&](T p_prime) { results[p_worker].push_back(p_prime); });
+                    }
+                }
+                catch (...)
+                {
+                    errors[p_worker] = std::current_exception();
+                }
+            };
+
+            // The calling thread takes the first run rather than sitting idle. The workers join when they go out of
+            // scope, which also happens if starting one of them throws.
+            {
+                std::vector<std::jthread> workers;
+                workers.reserve(threadCount - 1);
+                for (uint64_t worker = 1; worker < threadCount; ++worker)
+                {
+                    workers.emplace_back(work, worker);
+                }
+                work(0);
+            }
+
+            for (const auto& error : errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+
+            ReserveForPrimes(p_container, p_n);
+            p_container.push_back(2);
+            for (const auto& result : results)
+            {
+                for (auto prime : result)
+                {
+                    p_container.push_back(prime);
+                }
+            }
+        }
+
+        /// <summary>
+        /// A lazy input range over the primes in [0, p_n), or over every prime representable by T if no bound is
+        /// given. The range is sieved one window at a time as it is consumed, in the same way as
+        /// SegmentedEratosthenes, so only the current window and the base primes are held in memory. This allows
+        /// for stopping early, or composing with range adaptors such as std::views::take_while, without paying for
+        /// the primes that are never used.
+        /// </summary>
+        /// <typeparam name="T">The integral type of the primes.</typeparam>
+        template <typename T>
+        class PrimeView : public std::ranges::view_interface<PrimeView<T>>
+        {
+        public:
+            /// <summary>
+            /// The iterator over the primes. Since the primes are generated in place, all iterators share the state
+            /// of their view, and the view must outlive them.
+            /// </summary>
+            class Iterator
+            {
+            public:
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+
+                Iterator() = default;
+
+                explicit Iterator(PrimeView* p_view)
+                    : m_view(p_view)
+                { }
+
+                T operator*() const
+                {
+                    return m_view->m_current;
+                }
+
+                Iterator& operator++()
+                {
+                    m_view->Next();
+                    return *this;
+                }
+
+                void operator++(int)
+                {
+                    ++*this;
+                }
+
+                bool operator==(std::default_sentinel_t) const
+                {
+                    return m_view->m_done;
+                }
+
+            private:
+                /// <summary>
+                /// The view that owns the generation state.
+                /// </summary>
+                PrimeView* m_view{};
+            };
+
+            /// <summary>
+            /// Create a view over every prime representable by T.
+            /// </summary>
+            PrimeView()
+                : PrimeView(std::numeric_limits<T>::max())
+            { }
+
+            /// <summary>
+            /// Create a view over the primes in [0, p_n).
+            /// </summary>
+            /// <param name="p_n">The exclusive upper bound of the primes.</param>
+            /// <param name="p_segmentSize">The number of bytes in a window. Each byte covers one odd number.</param>
+            explicit PrimeView(T p_n, std::size_t p_segmentSize = c_defaultSegmentSize)
+                : m_n(p_n),
+                  m_marks(std::clamp<std::size_t>(
+                      p_segmentSize, 1, static_cast<std::size_t>(std::numeric_limits<T>::max() / 2)))
+            { }
+
+            /// <summary>
+            /// Starts the generation. As this is an input range, this should only be called once.
+            /// </summary>
+            Iterator begin()
+            {
+                if (!m_started)
+                {
+                    m_started = true;
+                    Next();
+                }
+                return Iterator(this);
+            }
+
+            std::default_sentinel_t end() const
+            {
+                return std::default_sentinel;
+            }
+
+        private:
+            /// <summary>
+            /// Moves to the next prime, or marks the view as done if there are no more primes in the range.
+            /// </summary>
+            void Next()
+            {
+                if (m_current < 2)
+                {
+                    // 2 is the only prime not represented in the odd only windows.
+                    if (m_n > 2)
+                    {
+                        m_current = 2;
+                        SieveWindow();
+                    }
+                    else
+                    {
+                        m_done = true;
+                    }
+                    return;
+                }
+
+                while (true)
+                {
+                    for (; m_idx < m_windowSize; ++m_idx)
+                    {
+                        const auto value = m_low + 2 * static_cast<T>(m_idx) + 1;
+                        if (!m_marks[m_idx] && value != 1)
+                        {
+                            m_current = value;
+                            ++m_idx;
+                            return;
+                        }
+                    }
+
+                    const auto span = 2 * static_cast<T>(m_marks.size());
+                    if (m_n - m_low <= span)
+                    {
+                        m_done = true;
+                        return;
+                    }
+                    m_low += span;
+                    SieveWindow();
+                }
+            }
+
+            /// <summary>
+            /// Sieves the window starting at m_low, first extending the base primes if they do not reach the square
+            /// root of the end of the window.
+            /// </summary>
+            void SieveWindow()
+            {
+                const auto span = 2 * static_cast<T>(m_marks.size());
+                const auto high = m_n - m_low < span ? m_n : m_low + span;
+
+                const auto sqrt = detail::FloorSqrt<T>(high - 1);
+                if (m_baseLimit <= sqrt)
+                {
+                    // Grow geometrically so that the base primes are only recomputed a logarithmic number of times.
+                    m_baseLimit = std::max<T>(sqrt + 1, m_baseLimit <= sqrt / 2 ? sqrt + 1 : 2 * m_baseLimit);
+                    m_basePrimes.clear();
+                    Eratosthenes(m_basePrimes, m_baseLimit);
+                    if (!m_basePrimes.empty())
+                    {
+                        m_basePrimes.erase(m_basePrimes.begin());
+                    }
+                }
+
+                m_windowSize = static_cast<std::size_t>((high - m_low) / 2);
+                detail::SieveOddSegment<T>(std::span<uint8_t>(m_marks.data(), m_windowSize), m_low, m_basePrimes);
+                m_idx = 0;
+            }
+
+            /// <summary>
+            /// The exclusive upper bound of the primes.
+            /// </summary>
+            T m_n;
+
+            /// <summary>
+            /// The storage for the current window.
+            /// </summary>
+            std::vector<uint8_t> m_marks;
+
+            /// <summary>
+            /// The number of entries of the storage that are within the range for the current window. A size is
+            /// kept rather than a span so that copies of the view do not refer to the storage of the original.
+            /// </summary>
+            std::size_t m_windowSize{};
+
+            /// <summary>
+            /// The odd primes less than m_baseLimit.
+            /// </summary>
+            std::vector<T> m_basePrimes;
+
+            /// <summary>
+            /// The exclusive upper bound of the base primes.
+            /// </summary>
+            T m_baseLimit{};
+
+            /// <summary>
+            /// The even number the current window starts at.
+            /// </summary>
+            T m_low{};
+
+            /// <summary>
+            /// The index in the current window to continue searching from.
+            /// </summary>
+            std::size_t m_idx{};
+
+            /// <summary>
+            /// The prime the view is currently at.
+            /// </summary>
+            T m_current{};
+
+            /// <summary>
+            /// Whether begin has been called and the first prime found.
+            /// </summary>
+            bool m_started{};
+
+            /// <summary>
+            /// Whether all the primes in the range have been generated.
+            /// </summary>
+            bool m_done{};
+        };
+
+        /// <summary>
+        /// Creates a lazy range over every prime representable by T.
+        /// </summary>
+        template <typename T = int64_t>
+        PrimeView<T> Primes()
+        {
+            return PrimeView<T>();
+        }
+
+        /// <summary>
+        /// Creates a lazy range over the primes in [0, p_n).
+        /// </summary>
+        template <typename T>
+        PrimeView<T> Primes(T p_n)
+        {
+            return PrimeView<T>(p_n);
+        }
+
+        namespace detail
+        {
+            /// <summary>
+            /// The residues modulo 30 that are coprime to 30. Only numbers in these residue classes can be primes
+            /// larger than 5, so a wheel sieve stores one bit per residue which is one byte per 30 integers.
+            /// </summary>
+            constexpr std::array<uint8_t, 8> c_wheelResidues{ 1, 7, 11, 13, 17, 19, 23, 29 };
+
+            /// <summary>
+            /// Maps a value modulo 30 to its bit within a wheel byte, or to 8 if the residue is not on the wheel.
+            /// </summary>
+            constexpr std::array<uint8_t, 30> c_wheelBits = []()
+            {
+                std::array<uint8_t, 30> bits{};
+                bits.fill(8);
+                for (uint8_t i = 0; i < c_wheelResidues.size(); ++i)
+                {
+                    bits[c_wheelResidues[i]] = i;
+                }
+                return bits;
+            }();
+
+            /// <summary>
+            /// The value represented by the given bit ordinal in a wheel bitset.
+            /// </summary>
+            constexpr uint64_t WheelValue(uint64_t p_ordinal)
+            {
+                return p_ordinal / 8 * 30 + c_wheelResidues[p_ordinal % 8];
+            }
+
+            /// <summary>
+            /// The bit ordinal of a value on the wheel, i.e. a value that is coprime to 30.
+            /// </summary>
+            constexpr uint64_t WheelOrdinal(uint64_t p_value)
+            {
+                return p_value / 30 * 8 + c_wheelBits[p_value % 30];
+            }
+        }
+
+        /// <summary>
+        /// A read only view over a mod 30 wheel bitset of the primes in [0, Bound()). Bit i of word w is set when the
+        /// value on the wheel with ordinal 64w + i is prime, so every word covers 240 integers. The primes 2, 3 and 5
+        /// are not on the wheel and are accounted for separately.
+        /// </summary>
+        class WheelView
+        {
+        public:
+            /// <summary>
+            /// Create an empty view which has no primes.
+            /// </summary>
+            WheelView() = default;
+
+            /// <summary>
+            /// Create a view over existing wheel words.
+            /// </summary>
+            /// <param name="p_words">The wheel words. Bits for values at or past p_n must be clear.</param>
+            /// <param name="p_n">The exclusive upper bound of the values represented.</param>
+            WheelView(std::span<const uint64_t> p_words, uint64_t p_n)
+                : m_words(p_words),
+                  m_n(p_n)
+            { }
+
+            /// <summary>
+            /// The exclusive upper bound of the values this view can answer for.
+            /// </summary>
+            uint64_t Bound() const
+            {
+                return m_n;
+            }
+
+            /// <summary>
+            /// The underlying wheel words.
+            /// </summary>
+            std::span<const uint64_t> Words() const
+            {
+                return m_words;
+            }
+
+            /// <summary>
+            /// Checks if a value is prime. Values at or beyond Bound() are reported as not prime.
+            /// </summary>
+            bool IsPrime(uint64_t p_value) const
+            {
+                if (p_value >= m_n)
+                {
+                    return false;
+                }
+                if (p_value < 6)
+                {
+                    return p_value == 2 || p_value == 3 || p_value == 5;
+                }
+
+                if (detail::c_wheelBits[p_value % 30] == 8)
+                {
+                    return false;
+                }
+                const auto ordinal = detail::WheelOrdinal(p_value);
+                return (m_words[ordinal / 64] >> (ordinal % 64)) & 1;
+            }
+
+            /// <summary>
+            /// Invokes the callable with every prime in the view in ascending order. The bitset is walked one word at
+            /// a time and the set bits are extracted with countr_zero, so composites are never visited. If the
+            /// callable returns a bool, returning false stops the iteration.
+            /// </summary>
+            template <typename Fn>
+            void ForEachPrime(Fn&& p_fn) const
+            {
+                auto visit = [&p_fn](uint64_t p_prime)
+                {
+                    if constexpr (std::is_same_v<std::invoke_result_t<Fn&, uint64_t>, bool>)
+                    {
+                        return p_fn(p_prime);
+                    }
+                    else
+                    {
+                        p_fn(p_prime);
+                        return true;
+                    }
+                };
+
+                for (uint64_t small : { 2u, 3u, 5u })
+                {
+                    if (small < m_n && !visit(small))
+                    {
+                        return;
+                    }
+                }
+
+                for (std::size_t w = 0; w < m_words.size(); ++w)
+                {
+                    auto word = m_words[w];
+                    while (word != 0)
+                    {
+                        const auto bit = static_cast<uint64_t>(std::countr_zero(word));
+                        if (!visit(detail::WheelValue(w * 64 + bit)))
+                        {
+                            return;
+                        }
+                        word &= word - 1;
+                    }
+                }
+            }
+
+            /// <summary>
+            /// The number of primes in the view.
+            /// </summary>
+            uint64_t Count() const
+            {
+                uint64_t count = (m_n > 2) + (m_n > 3) + (m_n > 5);
+                for (auto word : m_words)
+                {
+                    count += std::popcount(word);
+                }
+                return count;
+            }
+
+        private:
+            /// <summary>
+            /// The wheel words that are viewed.
+            /// </summary>
+            std::span<const uint64_t> m_words;
+
+            /// <summary>
+            /// The exclusive upper bound of the values represented.
+            /// </summary>
+            uint64_t m_n{};
+        };
+
+        /// <summary>
+        /// A sieve of the range [0, p_n) stored as a mod 30 wheel. Only values coprime to 30 are represented and they
+        /// are bit packed, 8 residues to a byte, so every 30 values take 8 bits instead of the 30 bits of a
+        /// std::vector&lt;bool&gt; over the whole range, which is 3.75 times smaller. This is preferred over
+        /// Eratosthenes when the sieve is queried for primality or when the primes can be consumed without
+        /// materializing them.
+        /// </summary>
+        class WheelSieve
+        {
+        public:
+            /// <summary>
+            /// Sieve the range [0, p_n).
+            /// </summary>
+            /// <param name="p_n">The exclusive upper bound of the range.</param>
+            explicit WheelSieve(uint64_t p_n)
+                : m_words((p_n + 239) / 240, ~uint64_t{ 0 }),
+                  m_n(p_n)
+            {
+                if (m_words.empty())
+                {
+                    return;
+                }
+
+                // 1 is on the wheel but is not prime, and values in the last word past the range are not either.
+                m_words[0] &= ~uint64_t{ 1 };
+                const auto lastWord = m_words.size() - 1;
+                for (uint64_t bit = 0; bit < 64; ++bit)
+                {
+                    if (detail::WheelValue(lastWord * 64 + bit) >= p_n)
+                    {
+                        m_words[lastWord] &= ~(uint64_t{ 1 } << bit);
+                    }
+                }
+
+                // Cross off multiples of each prime, starting at its square. Only multiples with a cofactor on the
+                // wheel are on the wheel themselves, so walk the wheel for the cofactor.
+                for (uint64_t ordinal = 1; detail::WheelValue(ordinal) * detail::WheelValue(ordinal) < p_n; ++ordinal)
+                {
+                    if (!((m_words[ordinal / 64] >> (ordinal % 64)) & 1))
+                    {
+                        continue;
+                    }
+
+                    const auto prime = detail::WheelValue(ordinal);
+                    for (auto cofactor = ordinal; ; ++cofactor)
+                    {
+                        const auto composite = prime * detail::WheelValue(cofactor);
+                        if (composite >= p_n)
+                        {
+                            break;
+                        }
+
+                        const auto compositeOrdinal = detail::WheelOrdinal(composite);
+                        m_words[compositeOrdinal / 64] &= ~(uint64_t{ 1 } << (compositeOrdinal % 64));
+                    }
+                }
+            }
+
+            /// <summary>
+            /// Provides a read only view over the sieve.
+            /// </summary>
+            WheelView View() const
+            {
+                return WheelView(m_words, m_n);
+            }
+
+            /// <summary>
+            /// The exclusive upper bound of the sieved range.
+            /// </summary>
+            uint64_t Bound() const
+            {
+                return m_n;
+            }
+
+            /// <summary>
+            /// Checks if a value is prime. Values at or beyond Bound() are reported as not prime.
+            /// </summary>
+            bool IsPrime(uint64_t p_value) const
+            {
+                return View().IsPrime(p_value);
+            }
+
+            /// <summary>
+            /// Invokes the callable with every prime in the range in ascending order, see WheelView::ForEachPrime.
+            /// </summary>
+            template <typename Fn>
+            void ForEachPrime(Fn&& p_fn) const
+            {
+                View().ForEachPrime(std::forward<Fn>(p_fn));
+            }
+
+            /// <summary>
+            /// The number of primes in the range.
+            /// </summary>
+            uint64_t Count() const
+            {
+                return View().Count();
+            }
+
+        private:
+            /// <summary>
+            /// The wheel bitset. See WheelView for the layout.
+            /// </summary>
+            std::vector<uint64_t> m_words;
+
+            /// <summary>
+            /// The exclusive upper bound of the sieved range.
+            /// </summary>
+            uint64_t m_n;
+        };
+
+        /// <summary>
+        /// A prime raised to some exponent, as a term in a factorization.
+        /// </summary>
+        /// <typeparam name="T">The integral type of the prime.</typeparam>
+        template <typename T>
+        struct PrimePower
+        {
+            /// <summary>
+            /// The prime base.
+            /// </summary>
+            T m_prime;
+
+            /// <summary>
+            /// The number of times the prime divides the factored number.
+            /// </summary>
+            uint32_t m_exponent;
+        };
+
+        /// <summary>
+        /// The prime factorization of a number as (prime, exponent) pairs in ascending order of prime. The terms are
+        /// stored inline, which is enough for any 64 bit number since the product of the first 16 primes already
+        /// exceeds 2^64, so creating a factorization never allocates.
+        /// </summary>
+        /// <typeparam name="T">The integral type of the primes.</typeparam>
+        template <typename T>
+        class Factorization
+        {
+        public:
+            /// <summary>
+            /// The maximum number of distinct prime factors of a 64 bit number.
+            /// </summary>
+            static constexpr std::size_t c_maxFactors = 15;
+
+            /// <summary>
+            /// Appends a term to the factorization. Terms must be added in ascending order of prime.
+            /// </summary>
+            void Push(T p_prime, uint32_t p_exponent)
+            {
+                m_factors[m_size] = PrimePower<T>{ p_prime, p_exponent };
+                ++m_size;
+            }
+
+            const PrimePower<T>* begin() const
+            {
+                return m_factors.data();
+            }
+
+            const PrimePower<T>* end() const
+            {
+                return m_factors.data() + m_size;
+            }
+
+            std::size_t size() const
+            {
+                return m_size;
+            }
+
+            bool empty() const
+            {
+                return m_size == 0;
+            }
+
+            const PrimePower<T>& operator[](std::size_t p_idx) const
+            {
+                return m_factors[p_idx];
+            }
+
+        private:
+            /// <summary>
+            /// The terms of the factorization. Only the first m_size are valid.
+            /// </summary>
+            std::array<PrimePower<T>, c_maxFactors> m_factors{};
+
+            /// <summary>
+            /// The number of terms in the factorization.
+            /// </summary>
+            std::size_t m_size{};
+        };
+
+        /// <summary>
+        /// A table of the smallest prime factor of every value in [0, p_n), built with a linear (Euler) sieve which
+        /// visits every composite exactly once. The table allows a value to be factored in O(log n) by repeatedly
+        /// looking up and dividing out its smallest prime factor.
+        ///
+        /// Primes are stored in the table as 0, which acts as a sentinel. Since the smallest prime factor of a
+        /// composite c is at most sqrt(c), a narrow Width can be used to save memory as long as sqrt(p_n - 1) fits
+        /// in it, e.g. uint16_t tables cover values up to 2^32.
+        /// </summary>
+        /// <typeparam name="Width">The unsigned integral type stored for each value.</typeparam>
+        template <typename Width = uint32_t>
+        class SmallestPrimeFactors
+        {
+            static_assert(std::is_unsigned_v<Width>, "Width must be an unsigned integral type.");
+
+        public:
+            /// <summary>
+            /// Build the table for the range [0, p_n).
+            /// </summary>
+            /// <param name="p_n">The exclusive upper bound of the table.</param>
+            explicit SmallestPrimeFactors(uint64_t p_n)
+                : m_table(p_n, Width{ 0 }),
+                  m_n(p_n)
+            {
+                constexpr uint64_t maxFactor = std::numeric_limits<Width>::max();
+                if (p_n > 1 && maxFactor < 0xFFFF'FFFFull && detail::FloorSqrt<uint64_t>(p_n - 1) > maxFactor)
+                {
+                    throw std::out_of_range("The bound is too large for the width of the table.");
+                }
+
+                // Only primes up to sqrt(p_n - 1) are ever used as multipliers: the multiplier is never larger than
+                // the smallest prime factor of the value it multiplies, so it is at most the square root of their
+                // product.
+                const auto sqrt = p_n > 1 ? detail::FloorSqrt<uint64_t>(p_n - 1) : 0;
+                std::vector<uint64_t> primes;
+                for (uint64_t value = 2; value < p_n; ++value)
+                {
+                    const auto smallest = m_table[value] == 0 ? value : static_cast<uint64_t>(m_table[value]);
+                    if (smallest == value && value <= sqrt)
+                    {
+                        primes.push_back(value);
+                    }
+
+                    for (auto prime : primes)
+                    {
+                        if (prime > smallest || prime > (p_n - 1) / value)
+                        {
+                            break;
+                        }
+                        m_table[value * prime] = static_cast<Width>(prime);
+                    }
+                }
+            }
+
+            /// <summary>
+            /// The exclusive upper bound of the table.
+            /// </summary>
+            uint64_t Bound() const
+            {
+                return m_n;
+            }
+
+            /// <summary>
+            /// The smallest prime factor of a value in [2, Bound()). For a prime this is the value itself.
+            /// </summary>
+            uint64_t SmallestFactor(uint64_t p_value) const
+            {
+                const auto entry = m_table[p_value];
+                return entry == 0 ? p_value : static_cast<uint64_t>(entry);
+            }
+
+            /// <summary>
+            /// Checks if a value in [0, Bound()) is prime.
+            /// </summary>
+            bool IsPrime(uint64_t p_value) const
+            {
+                return p_value > 1 && m_table[p_value] == 0;
+            }
+
+            /// <summary>
+            /// Factors a value into (prime, exponent) pairs in ascending order of prime, without allocating. 0 and 1
+            /// have an empty factorization.
+            /// </summary>
+            /// <typeparam name="T">The integral type of the value.</typeparam>
+            /// <param name="p_value">The value to factor, which must be in [0, Bound()).</param>
+            /// <returns>The prime factorization of the value.</returns>
+            template <typename T>
+            Factorization<T> Factorize(T p_value) const
+            {
+                if constexpr (std::is_signed_v<T>)
+                {
+                    if (p_value < 0)
+                    {
+                        throw std::out_of_range("The value is outside of the table.");
+                    }
+                }
+                if (static_cast<uint64_t>(p_value) >= m_n)
+                {
+                    throw std::out_of_range("The value is outside of the table.");
+                }
+
+                Factorization<T> factors;
+                auto remaining = static_cast<uint64_t>(p_value);
+                while (remaining > 1)
+                {
+                    const auto prime = SmallestFactor(remaining);
+                    uint32_t exponent = 0;
+                    do
+                    {
+                        remaining /= prime;
+                        ++exponent;
+                    } while (remaining > 1 && SmallestFactor(remaining) == prime);
+
+                    factors.Push(static_cast<T>(prime), exponent);
+                }
+
+                return factors;
+            }
+
+        private:
+            /// <summary>
+            /// The smallest prime factor of each value, or 0 for primes (as well as 0 and 1).
+            /// </summary>
+            std::vector<Width> m_table;
+
+            /// <summary>
+            /// The exclusive upper bound of the table.
+            /// </summary>
+            uint64_t m_n;
+        };
+
+        /// <summary>
+        /// The default number of values in a window of ForEachMultiplicative. Each value needs its remaining cofactor
+        /// and its function value, so this is sized to stay within a typical L2 cache.
+        /// </summary>
+        constexpr std::size_t c_defaultMultiplicativeSegmentSize = 32 * 1024;
+
+        /// <summary>
+        /// Euler's totient as a prime power callback for ForEachMultiplicative: phi(p^e) = p^(e - 1) * (p - 1).
+        /// </summary>
+        struct Totient
+        {
+            template <typename T>
+            T operator()(T p_prime, uint32_t p_exponent) const
+            {
+                T result = p_prime - 1;
+                for (uint32_t i = 1; i < p_exponent; ++i)
+                {
+                    result *= p_prime;
+                }
+                return result;
+            }
+        };
+
+        /// <summary>
+        /// The Mobius function as a prime power callback for ForEachMultiplicative: mu(p) = -1 and mu(p^e) = 0 for
+        /// e > 1.
+        /// </summary>
+        struct Mobius
+        {
+            template <typename T>
+            std::make_signed_t<T> operator()(T, uint32_t p_exponent) const
+            {
+                return p_exponent == 1 ? -1 : 0;
+            }
+        };
+
+        /// <summary>
+        /// The number of divisors as a prime power callback for ForEachMultiplicative: d(p^e) = e + 1.
+        /// </summary>
+        struct DivisorCount
+        {
+            template <typename T>
+            T operator()(T, uint32_t p_exponent) const
+            {
+                return static_cast<T>(p_exponent + 1);
+            }
+        };
+
+        /// <summary>
+        /// The sum of divisors as a prime power callback for ForEachMultiplicative:
+        /// sigma(p^e) = 1 + p + ... + p^e.
+        /// </summary>
+        struct DivisorSum
+        {
+            template <typename T>
+            T operator()(T p_prime, uint32_t p_exponent) const
+            {
+                T result = 1;
+                T power = 1;
+                for (uint32_t i = 0; i < p_exponent; ++i)
+                {
+                    power *= p_prime;
+                    result += power;
+                }
+                return result;
+            }
+        };
+
+        /// <summary>
+        /// Evaluates a multiplicative arithmetic function for every value in [1, p_n) in one pass. The function is
+        /// defined by its value on prime powers, and f(ab) = f(a)f(b) is used for coprime a and b.
+        ///
+        /// The range is processed in windows. For each window, the primes up to sqrt(p_n - 1) are divided out of the
+        /// values they divide, accumulating f(p^e) as they go. Whatever cofactor is left after that must be 1 or a
+        /// single large prime. Memory use is bounded by the window size and the base primes, so results can be
+        /// streamed, e.g. to accumulate totient sums, without storing the whole table.
+        /// </summary>
+        /// <typeparam name="T">The integral type of the values.</typeparam>
+        /// <typeparam name="Fn">A callable of (T prime, uint32_t exponent) that returns f(prime^exponent).</typeparam>
+        /// <typeparam name="Consumer">A callable of (T value, R f(value)) invoked for each value in order.</typeparam>
+        /// <param name="p_n">The exclusive upper bound of the values.</param>
+        /// <param name="p_primePower">The value of the function on prime powers.</param>
+        /// <param name="p_consumer">Receives each value and its function value in ascending order.</param>
+        /// <param name="p_segmentSize">The number of values in a window.</param>
+        template <typename T, typename Fn, typename Consumer>
+        void ForEachMultiplicative(
+            T p_n,
+            Fn&& p_primePower,
+            Consumer&& p_consumer,
+            std::size_t p_segmentSize = c_defaultMultiplicativeSegmentSize)
+        {
+            using R = std::remove_cvref_t<std::invoke_result_t<Fn&, T, uint32_t>>;
+
+            if (p_n < 2)
+            {
+                return;
+            }
+
+            std::vector<T> basePrimes;
+            Eratosthenes(basePrimes, detail::FloorSqrt<T>(p_n - 1) + 1);
+
+            const auto segmentSize = std::max<std::size_t>(p_segmentSize, 1);
+            std::vector<T> remaining(segmentSize);
+            std::vector<R> values(segmentSize);
+
+            for (T low = 1; low < p_n; )
+            {
+                const auto count = static_cast<std::size_t>(std::min<T>(p_n - low, static_cast<T>(segmentSize)));
+                const auto high = low + static_cast<T>(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    remaining[i] = low + static_cast<T>(i);
+                    values[i] = R{ 1 };
+                }
+
+                for (auto prime : basePrimes)
+                {
+                    for (auto multiple = (low + prime - 1) / prime * prime; multiple < high; multiple += prime)
+                    {
+                        const auto idx = static_cast<std::size_t>(multiple - low);
+                        uint32_t exponent = 0;
+                        do
+                        {
+                            remaining[idx] /= prime;
+                            ++exponent;
+                        } while (remaining[idx] % prime == 0);
+
+                        values[idx] *= p_primePower(prime, exponent);
+                    }
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (remaining[i] > 1)
+                    {
+                        values[i] *= p_primePower(remaining[i], 1u);
+                    }
+                    p_consumer(low + static_cast<T>(i), values[i]);
+                }
+
+                low = high;
+            }
+        }
+
+        /// <summary>
+        /// Evaluates a multiplicative arithmetic function for every value in [1, p_n) into a table. See
+        /// ForEachMultiplicative for the details.
+        /// </summary>
+        /// <typeparam name="T">The integral type of the values.</typeparam>
+        /// <typeparam name="Fn">A callable of (T prime, uint32_t exponent) that returns f(prime^exponent).</typeparam>
+        /// <param name="p_n">The exclusive upper bound of the values.</param>
+        /// <param name="p_primePower">The value of the function on prime powers.</param>
+        /// <returns>A table of size p_n where index i holds f(i). Index 0 is value initialized.</returns>
+        template <typename T, typename Fn>
+        auto MultiplicativeSieve(T p_n, Fn&& p_primePower)
+        {
+            using R = std::remove_cvref_t<std::invoke_result_t<Fn&, T, uint32_t>>;
+
+            std::vector<R> table(static_cast<std::size_t>(std::max<T>(p_n, 0)));
+            ForEachMultiplicative(
+                p_n,
+                std::forward<Fn>(p_primePower),
+                [&table](T p_value, const R& p_result) { table[static_cast<std::size_t>(p_value)] = p_result; });
+
+            return table;
+        }
     }
 }
\ No newline at end of file
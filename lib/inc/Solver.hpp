@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "BigInt.hpp"
+
 namespace euler
 {
     // A Solver can solve Project Euler problems. Usually each Solver is one attempt or approach
@@ -14,10 +16,9 @@ namespace euler
     	// Create default constructor as virtual for proper polymorphic usage.
     	virtual ~Solver() = default;
     
-    	// Execute the solver and get the result. Right now all solutions are assumed to be integers
-    	// that fit within a signed 64 bit representation. However, if a larger range is needed this
-    	// may need to be updated to some custom large integer type.
-    	virtual int64_t operator()() = 0;
+    	// Execute the solver and get the result. All solutions are integers, which are arbitrary
+    	// precision so that parameterized solvers are not limited to a signed 64 bit range.
+    	virtual BigInt operator()() = 0;
     };
 }
 
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// This class iterates over all the permutations of a set of values like PermuteView, but in the order of Heap's
+// algorithm rather than lexicographic order. Each Advance changes the state by exactly one swap of two values, and
+// the swapped indices are reported, so a consumer can update anything derived from the state (a sum, a product of
+// digit values, a digit mask, ...) in O(1) per permutation instead of rebuilding it in O(n). The swaps are O(1)
+// amortized as well.
+//
+// Only full permutations are supported since a partial permutation cannot always change by one swap, and the
+// values are treated as distinct by position, so equal values give repeated states.
+template <typename T, typename Compare = std::compare_three_way>
+class SwapPermuteView : private Compare
+{
+    static_assert(
+        std::is_same_v<std::strong_ordering,
+                       decltype(std::declval<Compare>()(std::declval<T>(), std::declval<T>()))>,
+        "T must be strongly ordered via Compare.");
+
+public:
+    // The two indices swapped by the last Advance, m_first < m_second.
+    struct Swap
+    {
+        std::size_t m_first;
+        std::size_t m_second;
+    };
+
+    // Create a SwapPermuteView over all the data elements, i.e. there are n! states from this.
+    SwapPermuteView(std::span<T> p_data, const Compare& p_compare = Compare())
+        : Compare(p_compare),
+          m_state(p_data),
+          m_counters(p_data.size(), 0),
+          m_level(1),
+          m_lastSwap{ 0, 0 },
+          m_rank(0)
+    {
+        Reset();
+    }
+
+    // Not copyable to avoid concurrent access issues on the same data without proper synchronization.
+    SwapPermuteView(const SwapPermuteView&) = delete;
+    SwapPermuteView& operator=(const SwapPermuteView&) = delete;
+
+    // Moveable.
+    SwapPermuteView(SwapPermuteView&&) = default;
+    SwapPermuteView& operator=(SwapPermuteView&&) = default;
+
+    // Moves to the next permutation by swapping two values, which LastSwap then reports.
+    bool Advance()
+    {
+        // The iterative form of Heap's algorithm. m_counters[i] counts the swaps done at level i, which permutes
+        // the first i + 1 values, and the levels below it restart after each one. The even levels always swap
+        // with the first value while the odd levels rotate through them, which is what makes every prefix go
+        // through all of its permutations.
+        while (m_level < m_state.size())
+        {
+            if (m_counters[m_level] < m_level)
+            {
+                const auto other = m_level % 2 == 0 ? 0 : m_counters[m_level];
+                std::swap(m_state[other], m_state[m_level]);
+                m_lastSwap = Swap{ other, m_level };
+
+                ++m_counters[m_level];
+                m_level = 1;
+                ++m_rank;
+                return true;
+            }
+
+            m_counters[m_level] = 0;
+            ++m_level;
+        }
+
+        return false;
+    }
+
+    // Moves to the next permutation and calls p_onSwap(first, second) with the swapped indices, after the swap.
+    template <typename OnSwap>
+    bool Advance(OnSwap&& p_onSwap)
+    {
+        if (!Advance())
+        {
+            return false;
+        }
+
+        p_onSwap(m_lastSwap.m_first, m_lastSwap.m_second);
+        return true;
+    }
+
+    // The indices swapped by the last Advance. Both are 0 before the first one.
+    Swap LastSwap() const
+    {
+        return m_lastSwap;
+    }
+
+    // Move the permutation back to the initial state, which is sorted.
+    void Reset()
+    {
+        std::sort(
+            m_state.begin(),
+            m_state.end(),
+            [this](const T& p_left, const T& p_right) { return (*static_cast<Compare*>(this))(p_left, p_right) < 0; });
+        std::fill(m_counters.begin(), m_counters.end(), 0);
+        m_level = 1;
+        m_lastSwap = Swap{ 0, 0 };
+        m_rank = 0;
+    }
+
+    // The number of permutations, n!. Throws if it does not fit in 64 bits.
+    uint64_t Count() const
+    {
+        uint64_t count = 1;
+        for (uint64_t factor = 2; factor <= m_state.size(); ++factor)
+        {
+            if (count > std::numeric_limits<uint64_t>::max() / factor)
+            {
+                throw std::overflow_error("The number of permutations does not fit in 64 bits.");
+            }
+            count *= factor;
+        }
+
+        return count;
+    }
+
+    // The number of times the view has advanced since the initial state. This is the position in the order of
+    // Heap's algorithm, not a lexicographic rank.
+    uint64_t Rank() const
+    {
+        return m_rank;
+    }
+
+    // Provides the current view.
+    std::span<const T> Current()
+    {
+        return m_state;
+    }
+
+private:
+    // The values that are being permuted over.
+    std::span<T> m_state;
+
+    // The number of swaps done at each level since it last restarted.
+    std::vector<std::size_t> m_counters;
+
+    // The level to continue from on the next Advance.
+    std::size_t m_level;
+
+    // The indices swapped by the last Advance.
+    Swap m_lastSwap;
+
+    // The number of advances since the initial state.
+    uint64_t m_rank;
+};
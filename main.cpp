@@ -1,10 +1,13 @@
 ﻿#include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <utility>
 
+#include "BigInt.hpp"
 #include "problems.hpp"
+#include "PrimeCache.hpp"
 #include "Sieve.hpp"
 #include "Solver.hpp"
 #include "KeyedSchemaRouter.hpp"
@@ -48,7 +51,7 @@ namespace
         }
     };
 
-    using SolutionRouter = KeyedSchemaRouter<Key<uint32_t, std::string>, int64_t, CinParameterResolver, StaticExecutor>;
+    using SolutionRouter = KeyedSchemaRouter<Key<uint32_t, std::string>, BigInt, CinParameterResolver, StaticExecutor>;
 
     /// <summary>
     /// 
@@ -68,16 +71,32 @@ namespace
             .Register<P2Optimization1>(
                 K(2, "Naive Optimized -- Project Euler"), S(4'000'000ll),
                 K(2, "Naive Optimized -- Unbound"), S(Param<int64_t>("UpTo")))
+            .Register<P2Matrix>(
+                K(2, "Matrix -- Project Euler"), S(BigInt(4'000'000)),
+                K(2, "Matrix -- Unbound"), S(Param<BigInt>("UpTo")))
             .Register<P3>(
                 K(3, "Sieve -- Project Euler"), S(600'851'475'143ll),
                 K(3, "Sieve -- Unbound"), S(Param<int64_t>("Factorize")))
+            .Register<P3Rho>(
+                K(3, "Rho -- Project Euler"), S(600'851'475'143ll),
+                K(3, "Rho -- Unbound"), S(Param<int64_t>("Factorize")))
             .Register<P4>(
                 K(4, "Project Euler"), S(3),
                 K(4, "Unbound"), S(Param<int64_t>("Digits")))
+            .Register<P4Palindrome>(
+                K(4, "Palindrome Search -- Project Euler"), S(3),
+                K(4, "Palindrome Search -- Unbound"), S(Param<int64_t>("Digits")))
             .Register<P31>(
                 K(31, "Main"), S())
+            .Register<P31DynamicProgramming>(
+                K(31, "Dynamic Programming -- Project Euler"), S(200ll),
+                K(31, "Dynamic Programming -- Unbound"), S(Param<int64_t>("Amount")))
             .Register<P32>(
-                K(32, "Main"), S());
+                K(32, "Main"), S())
+            .Register<P32Mask>(
+                K(32, "Pandigital Mask -- Project Euler"), S(10ll, 1ll, 9ll),
+                K(32, "Pandigital Mask -- Unbound"),
+                S(Param<int64_t>("Base"), Param<int64_t>("MinDigit"), Param<int64_t>("MaxDigit")));
     }
 }
 
@@ -91,12 +110,23 @@ int main(int argc, char* argv[])
         ("SolverName", "The name of the solver. Only used in dynamic SolverSelection.", cxxopts::value<std::string>())
         ("ParameterResolution", "The strategies for parameter resolution. Only cin is accepted currently.", cxxopts::value<std::string>())
         ("ExecType", "The type of execution to run. One of single or experiment.", cxxopts::value<std::string>())
-        ("ExecCount", "The number of times to run the problem. Only used in experiment ExecType.", cxxopts::value<uint32_t>());
+        ("ExecCount", "The number of times to run the problem. Only used in experiment ExecType.", cxxopts::value<uint32_t>())
+        ("PrimeCache", "A file to cache sieved primes in across runs. Primes are sieved on every run if not given.", cxxopts::value<std::string>());
     options.allow_unrecognised_options();
     auto optionsResult = options.parse(argc, argv);
 
     SolutionRouter router;
     InitializeRouter(router);
+    router.Freeze();
+
+    // Solvers that need primes read them from the cache, which is grown on the first run that needs more, so later
+    // runs and the iterations of an experiment do not sieve again.
+    std::optional<sieve::PrimeCache> primeCache;
+    if (optionsResult.count("PrimeCache") > 0)
+    {
+        primeCache.emplace(optionsResult["PrimeCache"].as<std::string>());
+        sieve::PrimeCache::SetShared(&*primeCache);
+    }
 
     uint32_t solverId;
     std::string solverName;
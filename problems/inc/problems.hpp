@@ -7,18 +7,25 @@
 
 #include <cstdint>
 
+#include "BigInt.hpp"
+
 namespace euler
 {
-    int64_t P1(int64_t p_max);
+    BigInt P1(int64_t p_max);
 
     int64_t P2Naive(int64_t p_upTo);
     int64_t P2Optimization1(int64_t p_upTo);
+    BigInt P2Matrix(const BigInt& p_upTo);
 
     int64_t P3(int64_t p_number);
+    int64_t P3Rho(int64_t p_number);
 
     int64_t P4(int64_t p_digits);
+    int64_t P4Palindrome(int64_t p_digits);
 
     int64_t P31();
+    BigInt P31DynamicProgramming(int64_t p_amount);
 
     int64_t P32();
+    int64_t P32Mask(int64_t p_base, int64_t p_minDigit, int64_t p_maxDigit);
 }
\ No newline at end of file
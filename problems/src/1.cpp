@@ -2,11 +2,12 @@
 
 namespace euler
 {
-    int64_t P1(int64_t p_max)
+    BigInt P1(int64_t p_max)
     {
-        auto threeCount = (p_max - 1) / 3;
-        auto fiveCount = (p_max - 1) / 5;
-        auto fifteenCount = (p_max - 1) / 15;
+        // The sums exceed 64 bits once p_max is around 6 * 10^9, so they are computed in arbitrary precision.
+        const BigInt threeCount = (p_max - 1) / 3;
+        const BigInt fiveCount = (p_max - 1) / 5;
+        const BigInt fifteenCount = (p_max - 1) / 15;
 
         auto threeSum = ((3 + threeCount * 3) * threeCount);
         auto fiveSum = ((5 + fiveCount * 5) * fiveCount);
@@ -1,5 +1,8 @@
 #include "problems.hpp"
 
+#include "BigInt.hpp"
+#include "Fibonacci.hpp"
+
 namespace euler
 {
     int64_t P2Naive(int64_t p_upTo)
@@ -46,4 +49,11 @@ namespace euler
 
         return sum;
     }
-}
\ No newline at end of file
+
+    BigInt P2Matrix(const BigInt& p_upTo)
+    {
+        // The even terms are summed with a power of a 3x3 matrix rather than term by term, which handles bounds
+        // far beyond 64 bits, e.g. 10^100 takes a handful of matrix products.
+        return fibonacci::EvenFibonacciSumBelow(p_upTo);
+    }
+}
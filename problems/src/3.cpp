@@ -1,28 +1,51 @@
 #include "problems.hpp"
 
-#include "Sieve.hpp"
-
+#include <algorithm>
 #include <cmath>
-#include <vector>
-#include <utility>
+
+#include "Factorize.hpp"
+#include "PrimeCache.hpp"
+#include "Sieve.hpp"
 
 namespace euler
 {
     int64_t P3(int64_t p_number)
     {
-        auto lim = static_cast<int64_t>(std::sqrt(p_number)) + 1;
-        std::vector<int64_t> primes;
-        sieve::Eratosthenes(primes, lim);
-
-        for (auto it = primes.crbegin(); it != primes.crend(); ++it)
+        // Divide out the prime factors in ascending order. Once the next prime squared exceeds what is left over, the
+        // remainder is either 1 or is itself the largest prime factor, so the loop only runs up to the larger of the
+        // second largest prime factor and the square root of the largest one. The primes come from the prime cache
+        // when the driver has one, and are otherwise generated lazily, a whole segment at a time. Either way no
+        // prime past the square root of the number is needed, and the estimate of it is rounded up generously.
+        int64_t largest = 0;
+        const auto bound = static_cast<int64_t>(std::sqrt(static_cast<double>(std::max<int64_t>(p_number, 0)))) + 2;
+        sieve::ForEachPrimeBelow(bound, [&](int64_t p_prime)
         {
-            if (p_number % *it == 0)
+            if (p_prime > p_number / p_prime)
             {
-                return *it;
+                return false;
             }
+
+            while (p_number % p_prime == 0)
+            {
+                largest = p_prime;
+                p_number /= p_prime;
+            }
+            return true;
+        });
+
+        // TODO: Figure out what to do for numbers with no prime factors (less than 2).
+        return p_number > 1 ? p_number : largest;
+    }
+
+    int64_t P3Rho(int64_t p_number)
+    {
+        if (p_number < 2)
+        {
+            return 0;
         }
 
-        // TODO: Figure out what to do here.
-        return 0;
+        // The factorization is in ascending order of prime so the last term is the largest.
+        const auto factors = factor::Factorize(static_cast<uint64_t>(p_number));
+        return static_cast<int64_t>(factors[factors.size() - 1].m_prime);
     }
 }
\ No newline at end of file
@@ -2,8 +2,13 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 
+#include "BigInt.hpp"
+#include "CoinChange.hpp"
+
 namespace
 {
     // Stores necessary state on the queue for what needs to be processed.
@@ -51,5 +56,16 @@ namespace euler
 
         return dpState[c_desiredAmount];
     }
-}
 
+    BigInt P31DynamicProgramming(int64_t p_amount)
+    {
+        if (p_amount < 0)
+        {
+            throw std::out_of_range("The amount must not be negative.");
+        }
+
+        // The number of ways overflows 64 bits for amounts around 35000.
+        constexpr std::array<uint64_t, 8> denominations = { 1, 2, 5, 10, 20, 50, 100, 200 };
+        return coins::CountWays<BigInt>(static_cast<uint64_t>(p_amount), denominations);
+    }
+}
@@ -10,47 +10,163 @@
 
 #include "problems.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstdlib>
 #include <optional>
+#include <stdexcept>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
-#include "PermuteView.hpp"
+#include "Digits.hpp"
+#include "PackedPermuteView.hpp"
 
 namespace
 {
-    template <typename T>
-    T DigitsToNumber(std::span<const uint8_t> p_digits)
+    // Finds the identities a * b = c whose digits together use every digit of a set exactly once, and sums the
+    // distinct products c. With n digits in the set, a and b together must have ceil(n / 2) digits and c the rest.
+    //
+    // Digit usage is tracked in a 16 bit mask. b is built from its least significant digit up, and since the low k
+    // digits of c only depend on the low k digits of b, each digit of c is checked against the mask as soon as it
+    // is known. That cuts almost every branch long before b is complete, and nothing is allocated while searching.
+    template <uint32_t Base>
+    class PandigitalSearch
     {
-        T result{};
-        T multiplier = 1;
+    public:
+        explicit PandigitalSearch(uint16_t p_digits)
+            : m_digits(p_digits)
+        {
+            const auto total = std::popcount(p_digits);
+            m_factorLength = (total + 1) / 2;
+            m_productLength = total - m_factorLength;
+        }
 
-        for (auto reverseIt = p_digits.rbegin(); reverseIt != p_digits.rend(); ++reverseIt)
+        int64_t Sum()
         {
-            result += *reverseIt * multiplier;
-            multiplier *= 10;
+            if (m_productLength == 0)
+            {
+                return 0;
+            }
+
+            // The pairs are symmetric so a never needs more digits than b.
+            for (m_aLength = 1; m_aLength <= m_factorLength / 2; ++m_aLength)
+            {
+                m_bLength = m_factorLength - m_aLength;
+                SearchA(0, 0, 0);
+            }
+
+            std::sort(m_products.begin(), m_products.end());
+            m_products.erase(std::unique(m_products.begin(), m_products.end()), m_products.end());
+
+            int64_t sum{};
+            for (auto product : m_products)
+            {
+                sum += static_cast<int64_t>(product);
+            }
+
+            return sum;
         }
 
-        return result;
-    }
+    private:
+        static constexpr uint16_t Bit(uint64_t p_digit)
+        {
+            return static_cast<uint16_t>(1u << p_digit);
+        }
 
-    std::vector<uint8_t> NumberToDigits(int64_t p_number)
-    {
-        if (p_number == 0)
+        void SearchA(int p_length, uint64_t p_a, uint16_t p_used)
+        {
+            if (p_length == m_aLength)
+            {
+                m_a = p_a;
+                SearchB(0, 0, p_used);
+                return;
+            }
+
+            for (uint64_t digit = p_length == 0 ? 1 : 0; digit < Base; ++digit)
+            {
+                if ((m_digits & ~p_used & Bit(digit)) != 0)
+                {
+                    SearchA(p_length + 1, p_a * Base + digit, static_cast<uint16_t>(p_used | Bit(digit)));
+                }
+            }
+        }
+
+        void SearchB(int p_position, uint64_t p_b, uint16_t p_used)
         {
-            return { 0 };
+            if (p_position == m_bLength)
+            {
+                CheckProduct(p_b, p_used);
+                return;
+            }
+
+            const auto power = euler::digits::c_powers<Base>[p_position];
+            for (uint64_t digit = p_position == m_bLength - 1 ? 1 : 0; digit < Base; ++digit)
+            {
+                if ((m_digits & ~p_used & Bit(digit)) == 0)
+                {
+                    continue;
+                }
+
+                const auto b = p_b + digit * power;
+                const auto used = static_cast<uint16_t>(p_used | Bit(digit));
+                const auto productDigit = m_a * b / power % Base;
+                if ((m_digits & ~used & Bit(productDigit)) != 0)
+                {
+                    SearchB(p_position + 1, b, static_cast<uint16_t>(used | Bit(productDigit)));
+                }
+            }
         }
 
-        std::vector<uint8_t> result; 
-        while (p_number > 0)
+        void CheckProduct(uint64_t p_b, uint16_t p_used)
         {
-            uint8_t digit = p_number % 10;
-            result.push_back(digit);
-            p_number /= 10;
+            const auto product = m_a * p_b;
+            if (euler::digits::Count<Base>(product) != static_cast<std::size_t>(m_productLength))
+            {
+                return;
+            }
+
+            // The low digits of the product were already checked, so the high digits must be exactly the rest.
+            auto remaining = static_cast<uint16_t>(m_digits & ~p_used);
+            for (auto high = product / euler::digits::c_powers<Base>[m_bLength]; high > 0; high /= Base)
+            {
+                if ((remaining & Bit(high % Base)) == 0)
+                {
+                    return;
+                }
+                remaining = static_cast<uint16_t>(remaining & ~Bit(high % Base));
+            }
+
+            if (remaining == 0)
+            {
+                m_products.push_back(product);
+            }
         }
 
-        return result;
+        uint16_t m_digits;
+        int m_factorLength{};
+        int m_productLength{};
+        int m_aLength{};
+        int m_bLength{};
+        uint64_t m_a{};
+        std::vector<uint64_t> m_products;
+    };
+
+    template <uint32_t Base>
+    int64_t SumPandigitalProducts(uint16_t p_digits)
+    {
+        return PandigitalSearch<Base>(p_digits).Sum();
     }
+
+    // The searches for every supported base, indexed by the base minus 2, so that each one divides by a constant.
+    template <std::size_t... Is>
+    constexpr auto MakePandigitalSearches(std::index_sequence<Is...>)
+    {
+        return std::array{ &SumPandigitalProducts<static_cast<uint32_t>(Is + 2)>... };
+    }
+
+    constexpr auto c_pandigitalSearches = MakePandigitalSearches(std::make_index_sequence<15>());
 }
 
 namespace euler
@@ -58,24 +174,39 @@ namespace euler
     int64_t P32()
     {
         std::array<uint8_t, 9> data{ 1, 2, 3, 4, 5, 6, 7, 8, 9 };
-        PermuteView<uint8_t> permuteView(data, 5);
+        PackedPermuteView<9> permuteView(data, 5);
         std::unordered_set<int64_t> pandigitalProducts;
 
         do
         {
-            auto lhsDigits = permuteView.Current();
-            auto rhsDigits = permuteView.Hidden();
-            std::unordered_multiset<int64_t> rhsDigitsSet(rhsDigits.begin(), rhsDigits.end());
+            // The visible digits are packed in nibbles, most significant first, and the hidden digits are a mask,
+            // so nothing is unpacked.
+            const auto lhsDigits = permuteView.CurrentPacked();
+            const auto rhsDigits = permuteView.HiddenMask();
 
             auto checkPandigitalAt = [&](std::size_t p_divisionPoint)
             {
-                auto a = DigitsToNumber<int32_t>(lhsDigits.subspan(0, p_divisionPoint));
-                auto b = DigitsToNumber<int32_t>(lhsDigits.subspan(p_divisionPoint));
+                int32_t a{};
+                int32_t b{};
+                for (std::size_t i = 0; i < 5; ++i)
+                {
+                    auto& operand = i < p_divisionPoint ? a : b;
+                    operand = operand * 10 + static_cast<int32_t>((lhsDigits >> (4 * i)) & 0xF);
+                }
                 auto product = a * b;
-                auto productDigits = NumberToDigits(product);
-                std::unordered_multiset<int64_t> productDigitSet(productDigits.begin(), productDigits.end());
 
-                if (rhsDigitsSet == productDigitSet)
+                // The product uses the hidden digits exactly when it has 4 digits and they cover the same 4 bits.
+                if (product < 1000 || product > 9999)
+                {
+                    return;
+                }
+
+                uint32_t productDigits{};
+                for (auto rest = product; rest > 0; rest /= 10)
+                {
+                    productDigits |= 1u << (rest % 10);
+                }
+                if (productDigits == rhsDigits)
                 {
                     pandigitalProducts.insert(product);
                 }
@@ -93,4 +224,20 @@ namespace euler
 
         return sum;
     }
+
+    int64_t P32Mask(int64_t p_base, int64_t p_minDigit, int64_t p_maxDigit)
+    {
+        // Digit usage is tracked in 16 bit masks.
+        if (p_base < 2 || p_base > 16)
+        {
+            throw std::out_of_range("Only bases 2 to 16 are supported.");
+        }
+        if (p_minDigit < 0 || p_minDigit > p_maxDigit || p_maxDigit >= p_base)
+        {
+            throw std::out_of_range("The digits must be a non-empty range of digits of the base.");
+        }
+
+        const auto digits = static_cast<uint16_t>(((1u << (p_maxDigit + 1)) - 1) & ~((1u << p_minDigit) - 1));
+        return c_pandigitalSearches[static_cast<std::size_t>(p_base - 2)](digits);
+    }
 }
@@ -2,46 +2,58 @@
 
 #include <mg/math.hpp>
 
+#include "Digits.hpp"
+#include "Palindrome.hpp"
+
 #include <algorithm>
 #include <array>
-#include <limits>
+#include <atomic>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace
 {
-    constexpr bool IsPalindromeDigit(int64_t p_num)
+    // Checks if a palindrome is the product of two factors in [p_low, p_high]. The search only needs to cover the
+    // values that can pair with a factor in range, i.e. [p_palindrome / p_high, p_high]. Even length palindromes are
+    // multiples of 11, and since 11 is prime one of the two factors must be too, so only multiples of 11 need to be
+    // tried for those.
+    bool HasFactorPair(int64_t p_palindrome, int64_t p_low, int64_t p_high, bool p_multipleOf11)
     {
-        if (p_num < 0)
+        auto first = std::max((p_palindrome + p_high - 1) / p_high, p_low);
+        auto step = int64_t{ 1 };
+        if (p_multipleOf11)
         {
-            return false;
+            step = 11;
+            first = (first + 10) / 11 * 11;
         }
-
-        if (p_num < 10)
+        else
         {
-            return true;
+            // Without the constraint, the pairs are symmetric so only the larger factor needs to be searched.
+            first = std::max(first, static_cast<int64_t>(std::ceil(std::sqrt(static_cast<double>(p_palindrome)))));
         }
 
-        constexpr auto maxDigits = std::numeric_limits<int64_t>::digits10 + 1;
-        std::array<int8_t, maxDigits> reverseDigits;
-
-        auto idx = 0;
-        while (p_num > 0)
+        // An odd palindrome only has odd factors, so every other candidate can be skipped.
+        if (p_palindrome % 2 == 1)
         {
-            auto remainder = static_cast<int8_t>(p_num % 10);
-            p_num /= 10;
-            reverseDigits[idx] = remainder;
-            ++idx;
+            if (first % 2 == 0)
+            {
+                first += step;
+            }
+            step *= 2;
         }
 
-        auto numOfDigits = idx;
-        for (auto i = 0; i < (numOfDigits + 1) / 2; ++i)
+        for (auto factor = first; factor <= p_high; factor += step)
         {
-            if (reverseDigits[i] != reverseDigits[numOfDigits - (i + 1)])
+            if (p_palindrome % factor == 0)
             {
-                return false;
+                return true;
             }
         }
 
-        return true;
+        return false;
     }
 }
 
@@ -51,15 +63,31 @@ namespace euler
     {
         auto limit = mg::whole_pow(10ll, p_digits);
 
+        // The products of each row are checked in batches so that the palindrome kernel can work on many values at
+        // once.
+        constexpr int64_t c_batchSize = 256;
+        std::array<int64_t, c_batchSize> products{};
+        std::array<bool, c_batchSize> isPalindrome{};
+
         int64_t maxPalindrome = 0;
         for (int64_t first = 0; first < limit; ++first)
         {
-            for (int64_t second = 0; second < limit; ++second)
+            for (int64_t second = 0; second < limit; second += c_batchSize)
             {
-                auto product = first * second;
-                if (IsPalindromeDigit(product))
+                const auto count = std::min<int64_t>(c_batchSize, limit - second);
+                for (int64_t i = 0; i < count; ++i)
                 {
-                    maxPalindrome = std::max(product, maxPalindrome);
+                    products[i] = first * (second + i);
+                }
+
+                const auto batch = std::span<const int64_t>(products.data(), static_cast<std::size_t>(count));
+                palindrome::ArePalindromes(batch, isPalindrome);
+                for (int64_t i = 0; i < count; ++i)
+                {
+                    if (isPalindrome[i])
+                    {
+                        maxPalindrome = std::max(products[i], maxPalindrome);
+                    }
                 }
             }
         }
@@ -67,4 +95,84 @@ namespace euler
         return maxPalindrome;
 
     }
+
+    int64_t P4Palindrome(int64_t p_digits)
+    {
+        // Products of two 10 digit numbers can overflow 64 bits.
+        if (p_digits < 1 || p_digits > 9)
+        {
+            throw std::out_of_range("Only 1 to 9 digit factors are supported.");
+        }
+
+        const auto limit = mg::whole_pow(10ll, p_digits);
+        const auto low = limit / 10;
+        const auto high = limit - 1;
+
+        // The largest products have 2n digits, so generate those palindromes in descending order from their first
+        // half. The halves are handed out to threads in blocks, in order, and once a palindrome is found no block
+        // after it needs to be searched since all its palindromes are smaller. Blocks before it must still finish
+        // since a larger palindrome might be found there.
+        constexpr int64_t c_blockSize = 64;
+        const auto halfCount = high - low + 1;
+        const auto blockCount = (halfCount + c_blockSize - 1) / c_blockSize;
+
+        std::atomic<int64_t> nextBlock = 0;
+        std::atomic<int64_t> foundBlock = blockCount;
+        std::atomic<int64_t> maxPalindrome = 0;
+        auto work = [&]()
+        {
+            for (auto block = nextBlock++; block < foundBlock; block = nextBlock++)
+            {
+                const auto blockStart = high - block * c_blockSize;
+                const auto blockEnd = std::max(blockStart - c_blockSize, low - 1);
+                for (auto half = blockStart; half > blockEnd; --half)
+                {
+                    const auto palindrome = half * limit + static_cast<int64_t>(digits::Reverse(half));
+                    if (HasFactorPair(palindrome, low, high, true))
+                    {
+                        auto found = foundBlock.load();
+                        while (block < found && !foundBlock.compare_exchange_weak(found, block))
+                        {
+                        }
+
+                        auto max = maxPalindrome.load();
+                        while (palindrome > max && !maxPalindrome.compare_exchange_weak(max, palindrome))
+                        {
+                        }
+                        break;
+                    }
+                }
+            }
+        };
+
+        const auto threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        {
+            // The workers join when they go out of scope, which also happens if starting one of them throws.
+            std::vector<std::jthread> workers;
+            workers.reserve(threadCount - 1);
+            for (auto i = 1u; i < threadCount; ++i)
+            {
+                workers.emplace_back(work);
+            }
+            work();
+        }
+
+        if (maxPalindrome > 0)
+        {
+            return maxPalindrome;
+        }
+
+        // Otherwise fall back to the 2n - 1 digit palindromes. This only happens for small n, e.g. n = 1 where the 2
+        // digit palindromes are all multiples of 11.
+        for (auto half = high; half >= low; --half)
+        {
+            const auto palindrome = half * (limit / 10) + static_cast<int64_t>(digits::Reverse(half / 10));
+            if (HasFactorPair(palindrome, low, high, false))
+            {
+                return palindrome;
+            }
+        }
+
+        return 0;
+    }
 }
\ No newline at end of file